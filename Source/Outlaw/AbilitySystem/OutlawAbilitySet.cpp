@@ -12,7 +12,8 @@ UOutlawAbilitySet::UOutlawAbilitySet(const FObjectInitializer& ObjectInitializer
 {
 }
 
-void UOutlawAbilitySet::GiveToAbilitySystem(UAbilitySystemComponent* ASC, UObject* SourceObject, FOutlawAbilitySetGrantedHandles& OutHandles) const
+void UOutlawAbilitySet::GiveToAbilitySystem(UAbilitySystemComponent* ASC, UObject* SourceObject, FOutlawAbilitySetGrantedHandles& OutHandles,
+	const FGameplayTagContainer& ExtraSpecTags) const
 {
 	if (!ASC)
 	{
@@ -36,6 +37,7 @@ void UOutlawAbilitySet::GiveToAbilitySystem(UAbilitySystemComponent* ASC, UObjec
 		{
 			AbilitySpec.GetDynamicSpecSourceTags().AddTag(AbilityInfo.InputTag);
 		}
+		AbilitySpec.GetDynamicSpecSourceTags().AppendTags(ExtraSpecTags);
 
 		const FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(AbilitySpec);
 		OutHandles.AbilitySpecHandles.Add(Handle);
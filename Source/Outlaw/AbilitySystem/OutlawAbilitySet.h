@@ -27,8 +27,10 @@ public:
 	 * @param ASC            The ability system component to grant to.
 	 * @param SourceObject   The object responsible for granting (e.g. equipment actor).
 	 * @param OutHandles     Filled with handles for later revocation.
+	 * @param ExtraSpecTags  Added to every granted ability spec's dynamic source tags (e.g. the weapon set it belongs to).
 	 */
-	void GiveToAbilitySystem(UAbilitySystemComponent* ASC, UObject* SourceObject, FOutlawAbilitySetGrantedHandles& OutHandles) const;
+	void GiveToAbilitySystem(UAbilitySystemComponent* ASC, UObject* SourceObject, FOutlawAbilitySetGrantedHandles& OutHandles,
+		const FGameplayTagContainer& ExtraSpecTags = FGameplayTagContainer::EmptyContainer) const;
 
 	/**
 	 * Populates the Abilities array from a DataTable of FOutlawAbilityTableRow rows.
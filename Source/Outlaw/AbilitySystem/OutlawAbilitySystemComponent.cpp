@@ -3,6 +3,7 @@
 #include "OutlawAbilitySystemComponent.h"
 #include "OutlawAbilitySet.h"
 #include "OutlawGameplayAbility.h"
+#include "Weapon/OutlawWeaponTypes.h"
 
 UOutlawAbilitySystemComponent::UOutlawAbilitySystemComponent()
 {
@@ -31,6 +32,18 @@ void UOutlawAbilitySystemComponent::RevokeAbilitySet(FOutlawAbilitySetGrantedHan
 	Handles.RevokeFromASC(this);
 }
 
+bool UOutlawAbilitySystemComponent::IsSpecInInactiveWeaponSet(const UAbilitySystemComponent& ASC, const FGameplayAbilitySpec& Spec)
+{
+	for (const FGameplayTag& SpecTag : Spec.GetDynamicSpecSourceTags())
+	{
+		if (SpecTag.MatchesTag(OutlawWeaponTags::WeaponSet) && !ASC.HasMatchingGameplayTag(SpecTag))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void UOutlawAbilitySystemComponent::AbilityInputTagPressed(const FGameplayTag& InputTag)
 {
 	if (InputTag.IsValid())
@@ -56,7 +69,7 @@ void UOutlawAbilitySystemComponent::ProcessAbilityInput()
 	{
 		for (FGameplayAbilitySpec& Spec : GetActivatableAbilities())
 		{
-			if (Spec.Ability && Spec.GetDynamicSpecSourceTags().HasTagExact(Tag))
+			if (Spec.Ability && Spec.GetDynamicSpecSourceTags().HasTagExact(Tag) && !IsSpecInInactiveWeaponSet(*this, Spec))
 			{
 				Spec.InputPressed = true;
 
@@ -37,6 +37,12 @@ public:
 	/** Per-frame processing of pending input state. Call from character Tick or input processing. */
 	void ProcessAbilityInput();
 
+	/**
+	 * True if the spec was granted for an ARPG weapon set (a Weapon.Set.* dynamic source tag) that is not the set
+	 * currently active on the ASC. Checked for every spec this component activates, whatever the ability's class.
+	 */
+	static bool IsSpecInInactiveWeaponSet(const UAbilitySystemComponent& ASC, const FGameplayAbilitySpec& Spec);
+
 protected:
 	virtual void BeginPlay() override;
 
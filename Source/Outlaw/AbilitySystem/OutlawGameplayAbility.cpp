@@ -2,6 +2,7 @@
 
 #include "OutlawGameplayAbility.h"
 #include "AbilitySystemComponent.h"
+#include "OutlawAbilitySystemComponent.h"
 
 UOutlawGameplayAbility::UOutlawGameplayAbility(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -10,6 +11,19 @@ UOutlawGameplayAbility::UOutlawGameplayAbility(const FObjectInitializer& ObjectI
 	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
 }
 
+bool UOutlawGameplayAbility::CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags, const FGameplayTagContainer* TargetTags, FGameplayTagContainer* OptionalRelevantTags) const
+{
+	if (!Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags))
+	{
+		return false;
+	}
+
+	// Covers activations that bypass UOutlawAbilitySystemComponent's input path (events, direct TryActivateAbility)
+	const UAbilitySystemComponent* ASC = ActorInfo ? ActorInfo->AbilitySystemComponent.Get() : nullptr;
+	const FGameplayAbilitySpec* Spec = ASC ? ASC->FindAbilitySpecFromHandle(Handle) : nullptr;
+	return !Spec || !UOutlawAbilitySystemComponent::IsSpecInInactiveWeaponSet(*ASC, *Spec);
+}
+
 void UOutlawGameplayAbility::OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec)
 {
 	Super::OnGiveAbility(ActorInfo, Spec);
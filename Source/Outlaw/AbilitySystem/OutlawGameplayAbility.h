@@ -42,6 +42,9 @@ public:
 	/** Returns the activation policy. */
 	EOutlawAbilityActivationPolicy GetActivationPolicy() const { return ActivationPolicy; }
 
+	/** Also fails while the spec belongs to an inactive ARPG weapon set (see UOutlawAbilitySystemComponent::IsSpecInInactiveWeaponSet). */
+	virtual bool CanActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayTagContainer* SourceTags = nullptr, const FGameplayTagContainer* TargetTags = nullptr, FGameplayTagContainer* OptionalRelevantTags = nullptr) const override;
+
 protected:
 	virtual void OnGiveAbility(const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilitySpec& Spec) override;
 	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
@@ -26,6 +26,63 @@ void UOutlawWeaponAttributeSet::GetLifetimeReplicatedProps(TArray<class FLifetim
 	DOREPLIFETIME_CONDITION_NOTIFY(UOutlawWeaponAttributeSet, CriticalStrikeChance, COND_None, REPNOTIFY_Always);
 }
 
+// ── Stat Blocks ─────────────────────────────────────────────────
+
+namespace OutlawWeaponStats
+{
+	struct FStatField
+	{
+		FGameplayAttribute Attribute;
+		float FOutlawWeaponStatBlock::* Field;
+	};
+
+	static const TArray<FStatField>& GetStatFields()
+	{
+		static const TArray<FStatField> Fields = {
+			{ UOutlawWeaponAttributeSet::GetFirepowerAttribute(), &FOutlawWeaponStatBlock::Firepower },
+			{ UOutlawWeaponAttributeSet::GetRPMAttribute(), &FOutlawWeaponStatBlock::RPM },
+			{ UOutlawWeaponAttributeSet::GetAccuracyAttribute(), &FOutlawWeaponStatBlock::Accuracy },
+			{ UOutlawWeaponAttributeSet::GetStabilityAttribute(), &FOutlawWeaponStatBlock::Stability },
+			{ UOutlawWeaponAttributeSet::GetCritMultiplierAttribute(), &FOutlawWeaponStatBlock::CritMultiplier },
+			{ UOutlawWeaponAttributeSet::GetWeaponRangeAttribute(), &FOutlawWeaponStatBlock::WeaponRange },
+			{ UOutlawWeaponAttributeSet::GetPhysicalDamageMinAttribute(), &FOutlawWeaponStatBlock::PhysicalDamageMin },
+			{ UOutlawWeaponAttributeSet::GetPhysicalDamageMaxAttribute(), &FOutlawWeaponStatBlock::PhysicalDamageMax },
+			{ UOutlawWeaponAttributeSet::GetAttackSpeedAttribute(), &FOutlawWeaponStatBlock::AttackSpeed },
+			{ UOutlawWeaponAttributeSet::GetCriticalStrikeChanceAttribute(), &FOutlawWeaponStatBlock::CriticalStrikeChance },
+		};
+		return Fields;
+	}
+}
+
+void UOutlawWeaponAttributeSet::ApplyStatBlock(UAbilitySystemComponent* ASC, const FOutlawWeaponStatBlock& Stats)
+{
+	if (!ASC || !ASC->GetSet<UOutlawWeaponAttributeSet>())
+	{
+		return;
+	}
+
+	for (const OutlawWeaponStats::FStatField& Stat : OutlawWeaponStats::GetStatFields())
+	{
+		const float NewValue = Stats.*Stat.Field;
+		if (ASC->GetNumericAttributeBase(Stat.Attribute) != NewValue)
+		{
+			ASC->SetNumericAttributeBase(Stat.Attribute, NewValue);
+		}
+	}
+}
+
+float* UOutlawWeaponAttributeSet::FindStat(FOutlawWeaponStatBlock& Stats, const FGameplayAttribute& Attribute)
+{
+	for (const OutlawWeaponStats::FStatField& Stat : OutlawWeaponStats::GetStatFields())
+	{
+		if (Stat.Attribute == Attribute)
+		{
+			return &(Stats.*Stat.Field);
+		}
+	}
+	return nullptr;
+}
+
 // ── Rep Notifies ────────────────────────────────────────────────
 
 void UOutlawWeaponAttributeSet::OnRep_Firepower(const FGameplayAttributeData& OldValue) const
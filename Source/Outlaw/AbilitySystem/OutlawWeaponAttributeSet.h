@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
 #include "AttributeSet.h"
+#include "Weapon/OutlawWeaponTypes.h"
 #include "OutlawWeaponAttributeSet.generated.h"
 
 /**
@@ -21,6 +22,18 @@ public:
 	UOutlawWeaponAttributeSet();
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
 
+	// ── Stat Blocks ─────────────────────────────────────────────
+
+	/**
+	 * Write a stat block to the base values of the ASC's weapon attributes in one pass.
+	 * Attributes whose base value already matches are skipped, so swapping between similar weapons only
+	 * re-aggregates what actually differs. Active modifiers (affix effects etc.) still apply on top.
+	 */
+	static void ApplyStatBlock(UAbilitySystemComponent* ASC, const FOutlawWeaponStatBlock& Stats);
+
+	/** The stat block field backing a weapon attribute, or null if the attribute is not one of this set's. */
+	static float* FindStat(FOutlawWeaponStatBlock& Stats, const FGameplayAttribute& Attribute);
+
 	// ── Shooter Attributes ──────────────────────────────────────
 
 	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_Firepower, Category = "Weapon|Shooter")
@@ -15,26 +15,137 @@
 #include "Weapon/OutlawWeaponModDefinition.h"
 #include "Weapon/OutlawWeaponTypes.h"
 #include "Net/UnrealNetwork.h"
+#include "Engine/World.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "TimerManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogOutlawInventory, Log, All);
 
+/** Per-entry flags accumulated between change-set flushes. */
+namespace OutlawInventoryChange
+{
+	constexpr uint8 Added   = 1 << 0;
+	constexpr uint8 Removed = 1 << 1;
+	constexpr uint8 Changed = 1 << 2;
+	constexpr uint8 Moved   = 1 << 3;
+
+	// Bookkeeping only, never passed to NoteEntryChange. Flags alone cannot tell add-then-remove from
+	// remove-then-add (a reused InstanceId, e.g. after LoadInventory), so existence is tracked at both ends.
+	constexpr uint8 ExistedAtStart = 1 << 6;
+	constexpr uint8 ExistsNow      = 1 << 7;
+}
+
+/** Offline packing for AutoArrangeGrid and CanFitItems. Works on scratch masks only, never the live grid. */
+namespace OutlawGridPacking
+{
+	/** Perturbation rounds AutoArrangeGrid may run after the seed orders, budget permitting. */
+	constexpr int32 MaxRefineIterations = 512;
+
+	struct FPiece
+	{
+		int32 W = 1;
+		int32 H = 1;
+	};
+
+	/** Lower is better: rows the layout spans first, then how far pieces sit from the top-left. */
+	struct FLayoutScore
+	{
+		int32 UsedRows = MAX_int32;
+		int64 Spread = MAX_int64;
+
+		bool operator<(const FLayoutScore& Other) const
+		{
+			return UsedRows != Other.UsedRows ? UsedRows < Other.UsedRows : Spread < Other.Spread;
+		}
+	};
+
+	/** First-fit each piece, in Order, onto Board. Fails as soon as one does not fit. */
+	bool Pack(FOutlawInventoryGridMask& Board, TConstArrayView<FPiece> Pieces, TConstArrayView<int32> Order, TArray<FIntPoint>& OutPositions)
+	{
+		OutPositions.SetNum(Pieces.Num());
+		for (const int32 PieceIdx : Order)
+		{
+			const FPiece& Piece = Pieces[PieceIdx];
+			int32 X = 0;
+			int32 Y = 0;
+			if (!Board.FindFreeRect(Piece.W, Piece.H, X, Y))
+			{
+				return false;
+			}
+
+			Board.SetRect(X, Y, Piece.W, Piece.H);
+			OutPositions[PieceIdx] = FIntPoint(X, Y);
+		}
+		return true;
+	}
+
+	FLayoutScore Score(TConstArrayView<FPiece> Pieces, TConstArrayView<FIntPoint> Positions, int32 GridWidth)
+	{
+		FLayoutScore Result;
+		Result.UsedRows = 0;
+		Result.Spread = 0;
+		for (int32 PieceIdx = 0; PieceIdx < Pieces.Num(); ++PieceIdx)
+		{
+			Result.UsedRows = FMath::Max(Result.UsedRows, Positions[PieceIdx].Y + Pieces[PieceIdx].H);
+			Result.Spread += static_cast<int64>(Positions[PieceIdx].Y) * GridWidth + Positions[PieceIdx].X;
+		}
+		return Result;
+	}
+
+	/** Deterministic candidate orders: big pieces first, under a few notions of "big". */
+	void SeedOrders(TConstArrayView<FPiece> Pieces, TArray<TArray<int32>>& OutOrders)
+	{
+		TArray<int32> Identity;
+		Identity.Reserve(Pieces.Num());
+		for (int32 PieceIdx = 0; PieceIdx < Pieces.Num(); ++PieceIdx)
+		{
+			Identity.Add(PieceIdx);
+		}
+
+		auto AddSorted = [&OutOrders, &Identity](auto Less)
+		{
+			TArray<int32>& Order = OutOrders.Add_GetRef(Identity);
+			Order.StableSort(Less);
+		};
+
+		AddSorted([Pieces](int32 A, int32 B) { return Pieces[A].W * Pieces[A].H > Pieces[B].W * Pieces[B].H; });
+		AddSorted([Pieces](int32 A, int32 B) { return Pieces[A].H != Pieces[B].H ? Pieces[A].H > Pieces[B].H : Pieces[A].W > Pieces[B].W; });
+		AddSorted([Pieces](int32 A, int32 B) { return Pieces[A].W != Pieces[B].W ? Pieces[A].W > Pieces[B].W : Pieces[A].H > Pieces[B].H; });
+		AddSorted([Pieces](int32 A, int32 B) { return FMath::Max(Pieces[A].W, Pieces[A].H) > FMath::Max(Pieces[B].W, Pieces[B].H); });
+	}
+}
+
 // ════════════════════════════════════════════════════════════════
 // FOutlawInventoryEntry — FFastArraySerializerItem callbacks
 // ════════════════════════════════════════════════════════════════
 
 void FOutlawInventoryEntry::PreReplicatedRemove(const FOutlawInventoryList& InArraySerializer)
 {
+	// The fast array swap-removes after this callback, so other entries' indices will shift
+	InArraySerializer.InvalidateInstanceIndex();
+
 	if (InArraySerializer.OwnerComponent)
 	{
-		InArraySerializer.OwnerComponent->BroadcastInventoryChanged();
+		InArraySerializer.OwnerComponent->UnstampReplicatedEntry(*this);
+		InArraySerializer.OwnerComponent->UnaccountEntry(*this);
+		InArraySerializer.OwnerComponent->NoteEntryChange(InstanceId, OutlawInventoryChange::Removed);
+		InArraySerializer.OwnerComponent->MarkReplicatedChangePending();
 	}
 }
 
 void FOutlawInventoryEntry::PostReplicatedAdd(const FOutlawInventoryList& InArraySerializer)
 {
+	InArraySerializer.InvalidateInstanceIndex();
+
 	if (InArraySerializer.OwnerComponent)
 	{
-		InArraySerializer.OwnerComponent->BroadcastInventoryChanged();
+		SeenSortOrder = SortOrder;
+		InArraySerializer.OwnerComponent->ReceiveServerEntryState(*this);
+		InArraySerializer.OwnerComponent->AccountEntry(*this);
+		InArraySerializer.OwnerComponent->RestampReplicatedEntry(*this);
+		InArraySerializer.OwnerComponent->NoteEntryChange(InstanceId, OutlawInventoryChange::Added);
+		InArraySerializer.OwnerComponent->MarkReplicatedChangePending();
 	}
 }
 
@@ -42,10 +153,83 @@ void FOutlawInventoryEntry::PostReplicatedChange(const FOutlawInventoryList& InA
 {
 	if (InArraySerializer.OwnerComponent)
 	{
-		InArraySerializer.OwnerComponent->BroadcastInventoryChanged();
+		// A pure move only touches GridX/GridY and a pure reorder only SortOrder; anything else counts as a change
+		const bool bCountChanged = AccountedItemDef != ItemDef || AccountedStackCount != StackCount;
+		if (AccountedItemDef != ItemDef)
+		{
+			// Hot fields mirror the definition
+			InArraySerializer.InvalidateInstanceIndex();
+		}
+		InArraySerializer.OwnerComponent->ReceiveServerEntryState(*this);
+		InArraySerializer.OwnerComponent->ReaccountEntry(*this);
+		const bool bMoved = InArraySerializer.OwnerComponent->RestampReplicatedEntry(*this);
+
+		const bool bReordered = SeenSortOrder != SortOrder;
+		SeenSortOrder = SortOrder;
+		if (bReordered)
+		{
+			InArraySerializer.OwnerComponent->NoteReorder();
+		}
+
+		uint8 ChangeFlags = bMoved ? OutlawInventoryChange::Moved : 0;
+		if (bCountChanged || (!bMoved && !bReordered))
+		{
+			ChangeFlags |= OutlawInventoryChange::Changed;
+		}
+		if (ChangeFlags)
+		{
+			InArraySerializer.OwnerComponent->NoteEntryChange(InstanceId, ChangeFlags);
+		}
+		InArraySerializer.OwnerComponent->MarkReplicatedChangePending();
+	}
+}
+
+// ════════════════════════════════════════════════════════════════
+// FOutlawInventoryList — FFastArraySerializer callbacks
+// ════════════════════════════════════════════════════════════════
+
+void FOutlawInventoryList::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (OwnerComponent)
+	{
+		OwnerComponent->FlushReplicatedChanges();
 	}
 }
 
+// ════════════════════════════════════════════════════════════════
+// FOutlawInventoryHotFields
+// ════════════════════════════════════════════════════════════════
+
+void FOutlawInventoryHotFields::Add(const UOutlawItemDefinition* ItemDef)
+{
+	UnitWeight.Add(ItemDef ? ItemDef->Weight : 0.0f);
+	GridWidth.Add(ItemDef ? static_cast<int16>(ItemDef->GridWidth) : 0);
+	GridHeight.Add(ItemDef ? static_cast<int16>(ItemDef->GridHeight) : 0);
+	MaxStackSize.Add(ItemDef ? FMath::Max(1, ItemDef->MaxStackSize) : 0);
+	Rarity.Add(ItemDef ? static_cast<uint8>(ItemDef->Rarity) : 0);
+	ItemType.Add(ItemDef ? static_cast<uint8>(ItemDef->ItemType) : 0);
+}
+
+void FOutlawInventoryHotFields::RemoveAt(int32 Index)
+{
+	UnitWeight.RemoveAt(Index);
+	GridWidth.RemoveAt(Index);
+	GridHeight.RemoveAt(Index);
+	MaxStackSize.RemoveAt(Index);
+	Rarity.RemoveAt(Index);
+	ItemType.RemoveAt(Index);
+}
+
+void FOutlawInventoryHotFields::Reset(int32 Slack)
+{
+	UnitWeight.Reset(Slack);
+	GridWidth.Reset(Slack);
+	GridHeight.Reset(Slack);
+	MaxStackSize.Reset(Slack);
+	Rarity.Reset(Slack);
+	ItemType.Reset(Slack);
+}
+
 // ════════════════════════════════════════════════════════════════
 // FOutlawInventoryList — Helpers
 // ════════════════════════════════════════════════════════════════
@@ -58,47 +242,154 @@ int32 FOutlawInventoryList::AddEntry(UOutlawItemDefinition* ItemDef, int32 Stack
 	NewEntry.InstanceId = InstanceId;
 	NewEntry.GridX = GridX;
 	NewEntry.GridY = GridY;
+	NewEntry.SortOrder = NextSortOrder++;
+
+	const int32 NewIndex = Entries.Num() - 1;
+	if (!bInstanceIndexDirty)
+	{
+		InstanceIndex.Add(InstanceId, NewIndex);
+		HotFields.Add(ItemDef);
+	}
+
+	if (OwnerComponent)
+	{
+		OwnerComponent->AccountEntry(NewEntry);
+		OwnerComponent->NoteEntryChange(InstanceId, OutlawInventoryChange::Added);
+	}
 
 	MarkItemDirty(NewEntry);
-	return Entries.Num() - 1;
+	return NewIndex;
 }
 
 bool FOutlawInventoryList::RemoveEntry(int32 InstanceId)
 {
-	for (int32 i = 0; i < Entries.Num(); ++i)
+	const int32 Index = IndexOfEntry(InstanceId);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveEntryAt(Index);
+	return true;
+}
+
+void FOutlawInventoryList::RemoveEntryAt(int32 Index)
+{
+	if (!Entries.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	if (OwnerComponent)
+	{
+		OwnerComponent->UnaccountEntry(Entries[Index]);
+		OwnerComponent->NoteEntryChange(Entries[Index].InstanceId, OutlawInventoryChange::Removed);
+	}
+
+	const int32 RemovedId = Entries[Index].InstanceId;
+	Entries.RemoveAt(Index);
+
+	if (!bInstanceIndexDirty)
 	{
-		if (Entries[i].InstanceId == InstanceId)
+		InstanceIndex.Remove(RemovedId);
+		HotFields.RemoveAt(Index);
+
+		// Everything after the removed slot shifted down by one
+		for (int32 i = Index; i < Entries.Num(); ++i)
 		{
-			Entries.RemoveAt(i);
-			MarkArrayDirty();
-			return true;
+			InstanceIndex.Add(Entries[i].InstanceId, i);
 		}
 	}
-	return false;
+
+	MarkArrayDirtyOrDefer();
 }
 
-FOutlawInventoryEntry* FOutlawInventoryList::FindEntry(int32 InstanceId)
+void FOutlawInventoryList::ResetEntries()
 {
-	for (FOutlawInventoryEntry& Entry : Entries)
+	if (OwnerComponent)
 	{
-		if (Entry.InstanceId == InstanceId)
+		for (FOutlawInventoryEntry& Entry : Entries)
 		{
-			return &Entry;
+			OwnerComponent->UnaccountEntry(Entry);
+			OwnerComponent->NoteEntryChange(Entry.InstanceId, OutlawInventoryChange::Removed);
 		}
 	}
-	return nullptr;
+
+	Entries.Reset();
+	InstanceIndex.Reset();
+	HotFields.Reset();
+	NextSortOrder = 0;
+	bInstanceIndexDirty = false;
+	MarkArrayDirtyOrDefer();
+}
+
+void FOutlawInventoryList::EndDeferredArrayDirty()
+{
+	check(DeferArrayDirtyDepth > 0);
+	if (--DeferArrayDirtyDepth == 0 && bArrayDirtyPending)
+	{
+		bArrayDirtyPending = false;
+		MarkArrayDirty();
+	}
+}
+
+void FOutlawInventoryList::MarkArrayDirtyOrDefer()
+{
+	if (DeferArrayDirtyDepth > 0)
+	{
+		bArrayDirtyPending = true;
+		return;
+	}
+
+	MarkArrayDirty();
+}
+
+FOutlawInventoryEntry* FOutlawInventoryList::FindEntry(int32 InstanceId)
+{
+	const int32 Index = IndexOfEntry(InstanceId);
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
 }
 
 const FOutlawInventoryEntry* FOutlawInventoryList::FindEntry(int32 InstanceId) const
 {
-	for (const FOutlawInventoryEntry& Entry : Entries)
+	const int32 Index = IndexOfEntry(InstanceId);
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+int32 FOutlawInventoryList::IndexOfEntry(int32 InstanceId) const
+{
+	if (bInstanceIndexDirty)
 	{
-		if (Entry.InstanceId == InstanceId)
-		{
-			return &Entry;
-		}
+		RebuildInstanceIndex();
 	}
-	return nullptr;
+
+	const int32* Index = InstanceIndex.Find(InstanceId);
+	return Index ? *Index : INDEX_NONE;
+}
+
+void FOutlawInventoryList::RebuildInstanceIndex() const
+{
+	InstanceIndex.Reset();
+	InstanceIndex.Reserve(Entries.Num());
+
+	HotFields.Reset(Entries.Num());
+
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		InstanceIndex.Add(Entries[i].InstanceId, i);
+		HotFields.Add(Entries[i].ItemDef);
+	}
+
+	bInstanceIndexDirty = false;
+}
+
+const FOutlawInventoryHotFields& FOutlawInventoryList::GetHotFields() const
+{
+	if (bInstanceIndexDirty)
+	{
+		RebuildInstanceIndex();
+	}
+	return HotFields;
 }
 
 // ════════════════════════════════════════════════════════════════
@@ -116,6 +407,8 @@ void UOutlawInventoryComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	RebuildEquipmentSlotIndex();
+
 	if (IsGridMode())
 	{
 		RebuildOccupancyGrid();
@@ -145,45 +438,48 @@ int32 UOutlawInventoryComponent::AddItem(UOutlawItemDefinition* ItemDef, int32 C
 		return 0;
 	}
 
+	if (RejectWhileLoading(TEXT("AddItem")))
+	{
+		return 0;
+	}
+
 	int32 Remaining = Count;
 
-	// First pass: fill existing stacks
+	// First pass: fill existing stacks. Only entries of this definition with room are visited;
+	// filling a stack to capacity drops it from OpenStackIds.
 	if (ItemDef->MaxStackSize > 1)
 	{
-		for (FOutlawInventoryEntry& Entry : InventoryList.Entries)
+		const FOutlawItemDefStacks* Stacks = StacksByDef.Find(ItemDef);
+		while (Remaining > 0 && Stacks && Stacks->OpenStackIds.Num() > 0)
 		{
-			if (Remaining <= 0)
+			FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Stacks->OpenStackIds[0]);
+			if (!Entry)
 			{
 				break;
 			}
 
-			if (Entry.ItemDef == ItemDef && Entry.StackCount < ItemDef->MaxStackSize)
-			{
-				const int32 SpaceInStack = ItemDef->MaxStackSize - Entry.StackCount;
-				const int32 ToAdd = FMath::Min(Remaining, SpaceInStack);
+			const int32 SpaceInStack = ItemDef->MaxStackSize - Entry->StackCount;
+			const int32 ToAdd = FMath::Min(Remaining, SpaceInStack);
 
-				// Check weight
-				const float WeightToAdd = ToAdd * ItemDef->Weight;
-				if (GetCurrentWeight() + WeightToAdd > MaxWeight)
+			// Check weight
+			const float WeightToAdd = ToAdd * ItemDef->Weight;
+			if (GetCurrentWeight() + WeightToAdd > MaxWeight)
+			{
+				const int32 CanFitByWeight = (MaxWeight > 0.0f && ItemDef->Weight > 0.0f)
+					? FMath::FloorToInt32((MaxWeight - GetCurrentWeight()) / ItemDef->Weight)
+					: ToAdd;
+				const int32 ActualAdd = FMath::Min(ToAdd, FMath::Max(0, CanFitByWeight));
+				if (ActualAdd <= 0)
 				{
-					const int32 CanFitByWeight = (MaxWeight > 0.0f && ItemDef->Weight > 0.0f)
-						? FMath::FloorToInt32((MaxWeight - GetCurrentWeight()) / ItemDef->Weight)
-						: ToAdd;
-					const int32 ActualAdd = FMath::Min(ToAdd, FMath::Max(0, CanFitByWeight));
-					if (ActualAdd <= 0)
-					{
-						break;
-					}
-					Entry.StackCount += ActualAdd;
-					Remaining -= ActualAdd;
-					InventoryList.MarkItemDirty(Entry);
 					break;
 				}
-
-				Entry.StackCount += ToAdd;
-				Remaining -= ToAdd;
-				InventoryList.MarkItemDirty(Entry);
+				SetEntryStackCount(*Entry, Entry->StackCount + ActualAdd);
+				Remaining -= ActualAdd;
+				break;
 			}
+
+			SetEntryStackCount(*Entry, Entry->StackCount + ToAdd);
+			Remaining -= ToAdd;
 		}
 	}
 
@@ -216,7 +512,7 @@ int32 UOutlawInventoryComponent::AddItem(UOutlawItemDefinition* ItemDef, int32 C
 				SetOccupancy(PlaceX, PlaceY, ItemDef->GridWidth, ItemDef->GridHeight, NewId);
 				if (ItemDef->IsWeapon())
 				{
-					InventoryList.Entries[EntryIdx].ItemInstance = CreateItemInstance(ItemDef, NewId);
+					InitWeaponEntry(InventoryList.Entries[EntryIdx]);
 				}
 			}
 			else
@@ -229,7 +525,7 @@ int32 UOutlawInventoryComponent::AddItem(UOutlawItemDefinition* ItemDef, int32 C
 				const int32 EntryIdx = InventoryList.AddEntry(ItemDef, ActualStack, NewId);
 				if (ItemDef->IsWeapon())
 				{
-					InventoryList.Entries[EntryIdx].ItemInstance = CreateItemInstance(ItemDef, NewId);
+					InitWeaponEntry(InventoryList.Entries[EntryIdx]);
 				}
 			}
 
@@ -249,7 +545,7 @@ int32 UOutlawInventoryComponent::AddItem(UOutlawItemDefinition* ItemDef, int32 C
 			SetOccupancy(PlaceX, PlaceY, ItemDef->GridWidth, ItemDef->GridHeight, NewId);
 			if (ItemDef->IsWeapon())
 			{
-				InventoryList.Entries[EntryIdx].ItemInstance = CreateItemInstance(ItemDef, NewId);
+				InitWeaponEntry(InventoryList.Entries[EntryIdx]);
 			}
 		}
 		else
@@ -262,7 +558,7 @@ int32 UOutlawInventoryComponent::AddItem(UOutlawItemDefinition* ItemDef, int32 C
 			const int32 EntryIdx = InventoryList.AddEntry(ItemDef, StackSize, NewId);
 			if (ItemDef->IsWeapon())
 			{
-				InventoryList.Entries[EntryIdx].ItemInstance = CreateItemInstance(ItemDef, NewId);
+				InitWeaponEntry(InventoryList.Entries[EntryIdx]);
 			}
 		}
 
@@ -279,7 +575,7 @@ int32 UOutlawInventoryComponent::AddItem(UOutlawItemDefinition* ItemDef, int32 C
 
 bool UOutlawInventoryComponent::RemoveItem(int32 InstanceId, int32 Count)
 {
-	if (!GetOwner()->HasAuthority())
+	if (!GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("RemoveItem")))
 	{
 		return false;
 	}
@@ -301,8 +597,7 @@ bool UOutlawInventoryComponent::RemoveItem(int32 InstanceId, int32 Count)
 	}
 	else
 	{
-		Entry->StackCount -= Count;
-		InventoryList.MarkItemDirty(*Entry);
+		SetEntryStackCount(*Entry, Entry->StackCount - Count);
 	}
 
 	BroadcastInventoryChanged();
@@ -311,22 +606,30 @@ bool UOutlawInventoryComponent::RemoveItem(int32 InstanceId, int32 Count)
 
 int32 UOutlawInventoryComponent::RemoveItemByDef(UOutlawItemDefinition* ItemDef, int32 Count)
 {
-	if (!ItemDef || Count <= 0 || !GetOwner()->HasAuthority())
+	if (!ItemDef || Count <= 0 || !GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("RemoveItemByDef")))
+	{
+		return 0;
+	}
+
+	const FOutlawItemDefStacks* Stacks = StacksByDef.Find(ItemDef);
+	if (!Stacks)
 	{
 		return 0;
 	}
 
 	int32 Remaining = Count;
 
-	// Iterate in reverse so removals don't invalidate indices
-	for (int32 i = InventoryList.Entries.Num() - 1; i >= 0 && Remaining > 0; --i)
+	// Copy: removing entries mutates the index. Drain the newest stacks first.
+	const TArray<int32> MatchingIds = Stacks->InstanceIds;
+	for (int32 i = MatchingIds.Num() - 1; i >= 0 && Remaining > 0; --i)
 	{
-		FOutlawInventoryEntry& Entry = InventoryList.Entries[i];
-		if (Entry.ItemDef != ItemDef)
+		const int32 Index = InventoryList.IndexOfEntry(MatchingIds[i]);
+		if (Index == INDEX_NONE)
 		{
 			continue;
 		}
 
+		FOutlawInventoryEntry& Entry = InventoryList.Entries[Index];
 		if (Remaining >= Entry.StackCount)
 		{
 			Remaining -= Entry.StackCount;
@@ -334,14 +637,12 @@ int32 UOutlawInventoryComponent::RemoveItemByDef(UOutlawItemDefinition* ItemDef,
 			{
 				ClearOccupancy(Entry.GridX, Entry.GridY, Entry.ItemDef->GridWidth, Entry.ItemDef->GridHeight);
 			}
-			InventoryList.Entries.RemoveAt(i);
-			InventoryList.MarkArrayDirty();
+			InventoryList.RemoveEntryAt(Index);
 		}
 		else
 		{
-			Entry.StackCount -= Remaining;
+			SetEntryStackCount(Entry, Entry.StackCount - Remaining);
 			Remaining = 0;
-			InventoryList.MarkItemDirty(Entry);
 		}
 	}
 
@@ -353,626 +654,2470 @@ int32 UOutlawInventoryComponent::RemoveItemByDef(UOutlawItemDefinition* ItemDef,
 	return Removed;
 }
 
-TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsByTag(FGameplayTag Tag) const
+bool UOutlawInventoryComponent::TransferItemTo(UOutlawInventoryComponent* Target, int32 InstanceId, int32 Count, int32 TargetX, int32 TargetY)
 {
-	TArray<FOutlawInventoryEntry> Result;
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
+	if (!Target || Target == this || !GetOwner()->HasAuthority() || !Target->GetOwner()->HasAuthority())
 	{
-		if (Entry.ItemDef && Entry.ItemDef->ItemTags.HasTag(Tag))
-		{
-			Result.Add(Entry);
-		}
+		return false;
 	}
-	return Result;
-}
 
-int32 UOutlawInventoryComponent::GetItemCount(const UOutlawItemDefinition* ItemDef) const
-{
-	int32 Total = 0;
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
+	if (RejectWhileLoading(TEXT("TransferItemTo")) || Target->RejectWhileLoading(TEXT("TransferItemTo")))
 	{
-		if (Entry.ItemDef == ItemDef)
-		{
-			Total += Entry.StackCount;
-		}
+		return false;
 	}
-	return Total;
-}
 
-bool UOutlawInventoryComponent::HasItem(const UOutlawItemDefinition* ItemDef, int32 Count) const
-{
-	return GetItemCount(ItemDef) >= Count;
-}
+	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!Entry || !Entry->ItemDef)
+	{
+		return false;
+	}
 
-float UOutlawInventoryComponent::GetCurrentWeight() const
-{
-	float Total = 0.0f;
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
+	UOutlawItemDefinition* ItemDef = Entry->ItemDef;
+	if (IsItemEquipped(InstanceId))
 	{
-		if (Entry.ItemDef)
-		{
-			Total += Entry.ItemDef->Weight * Entry.StackCount;
-		}
+		UE_LOG(LogOutlawInventory, Warning, TEXT("TransferItemTo: '%s' is equipped."), *ItemDef->DisplayName.ToString());
+		return false;
 	}
-	return Total;
-}
 
-int32 UOutlawInventoryComponent::GetRemainingSlots() const
-{
-	if (IsGridMode())
+	const int32 MoveCount = (Count <= 0 || Count >= Entry->StackCount) ? Entry->StackCount : Count;
+	const bool bWholeEntry = MoveCount == Entry->StackCount;
+
+	// ── Validate everything on the target before touching either side ──
+
+	const float WeightToAdd = MoveCount * ItemDef->Weight;
+	if (ItemDef->Weight > 0.0f && Target->GetCurrentWeight() + WeightToAdd > Target->MaxWeight)
 	{
-		int32 FreeCells = 0;
-		for (int32 Cell : OccupancyGrid)
+		return false;
+	}
+
+	// Top up the target's open stacks first, as AddItem does; only the remainder needs a slot or grid space.
+	// An explicit grid cell places everything there instead.
+	const bool bExplicitCell = TargetX != INDEX_NONE || TargetY != INDEX_NONE;
+	int32 MergeCount = 0;
+	if (ItemDef->MaxStackSize > 1 && !ItemDef->IsWeapon() && !bExplicitCell)
+	{
+		if (const FOutlawItemDefStacks* Stacks = Target->StacksByDef.Find(ItemDef))
 		{
-			if (Cell == INDEX_NONE)
+			for (const int32 OpenId : Stacks->OpenStackIds)
 			{
-				++FreeCells;
+				if (const FOutlawInventoryEntry* Open = Target->InventoryList.FindEntry(OpenId))
+				{
+					MergeCount += ItemDef->MaxStackSize - Open->StackCount;
+				}
 			}
 		}
-		return FreeCells;
+		MergeCount = FMath::Min(MergeCount, MoveCount);
 	}
-	return MaxSlots - InventoryList.Entries.Num();
-}
+	const int32 NewStackCount = MoveCount - MergeCount;
 
-TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsForSlot(FGameplayTag SlotTag) const
-{
-	TArray<FOutlawInventoryEntry> Result;
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
+	int32 PlaceX = INDEX_NONE;
+	int32 PlaceY = INDEX_NONE;
+	if (NewStackCount > 0 && Target->IsGridMode())
 	{
-		if (Entry.ItemDef && Entry.ItemDef->bCanBeEquipped && Entry.ItemDef->EquipmentSlotTag == SlotTag)
+		if (bExplicitCell)
 		{
-			Result.Add(Entry);
+			if (!Target->CanPlaceItemAt(ItemDef, TargetX, TargetY))
+			{
+				return false;
+			}
+			PlaceX = TargetX;
+			PlaceY = TargetY;
 		}
-	}
-	return Result;
-}
-
-TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsByType(EOutlawItemType ItemType) const
-{
-	TArray<FOutlawInventoryEntry> Result;
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
-	{
-		if (Entry.ItemDef && Entry.ItemDef->ItemType == ItemType)
+		else if (!Target->FindFreeSpace(ItemDef, PlaceX, PlaceY))
 		{
-			Result.Add(Entry);
+			return false;
 		}
 	}
-	return Result;
-}
-
-TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsByRarity(EOutlawItemRarity Rarity) const
-{
-	TArray<FOutlawInventoryEntry> Result;
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
+	else if (NewStackCount > 0 && Target->GetRemainingSlots() <= 0)
 	{
-		if (Entry.ItemDef && Entry.ItemDef->Rarity == Rarity)
-		{
-			Result.Add(Entry);
-		}
+		return false;
 	}
-	return Result;
-}
 
-// ── Sorting ─────────────────────────────────────────────────────
+	// ── Commit: nothing below can fail ──
 
-void UOutlawInventoryComponent::SortInventory(EOutlawInventorySortMode SortMode, bool bDescending)
-{
-	if (!GetOwner()->HasAuthority())
+	// Filling a stack drops it from OpenStackIds, so the next open one is always first
+	for (int32 ToMerge = MergeCount; ToMerge > 0;)
 	{
-		return;
+		const FOutlawItemDefStacks& Stacks = Target->StacksByDef.FindChecked(ItemDef);
+		FOutlawInventoryEntry* Open = Target->InventoryList.FindEntry(Stacks.OpenStackIds[0]);
+		const int32 ToAdd = FMath::Min(ToMerge, ItemDef->MaxStackSize - Open->StackCount);
+		Target->SetEntryStackCount(*Open, Open->StackCount + ToAdd);
+		ToMerge -= ToAdd;
 	}
 
-	InventoryList.Entries.Sort([SortMode, bDescending](const FOutlawInventoryEntry& A, const FOutlawInventoryEntry& B)
+	if (NewStackCount > 0)
 	{
-		// Null-def entries sink to the bottom
-		if (!A.ItemDef) return false;
-		if (!B.ItemDef) return true;
-
-		int32 Result = 0;
-
-		switch (SortMode)
+		const int32 NewId = Target->GenerateInstanceId();
+		const int32 TargetIdx = Target->InventoryList.AddEntry(ItemDef, NewStackCount, NewId, PlaceX, PlaceY);
+		if (Target->IsGridMode())
 		{
-		case EOutlawInventorySortMode::ByName:
-			Result = A.ItemDef->DisplayName.CompareTo(B.ItemDef->DisplayName);
-			break;
-
-		case EOutlawInventorySortMode::ByRarity:
-			Result = static_cast<int32>(A.ItemDef->Rarity) - static_cast<int32>(B.ItemDef->Rarity);
-			break;
+			Target->SetOccupancy(PlaceX, PlaceY, ItemDef->GridWidth, ItemDef->GridHeight, NewId);
+		}
+		FOutlawInventoryEntry& TargetEntry = Target->InventoryList.Entries[TargetIdx];
 
-		case EOutlawInventorySortMode::ByType:
-			Result = static_cast<int32>(A.ItemDef->ItemType) - static_cast<int32>(B.ItemDef->ItemType);
-			// Secondary sort by name within same type
-			if (Result == 0)
+		if (bWholeEntry && ItemDef->IsWeapon())
+		{
+			if (Entry->ItemInstance && !Target->bInlineWeaponState)
 			{
-				Result = A.ItemDef->DisplayName.CompareTo(B.ItemDef->DisplayName);
+				// Hand over the live instance so anything holding a pointer to it keeps seeing the same object
+				UOutlawItemInstance* Instance = Entry->ItemInstance;
+				Entry->ItemInstance = nullptr;
+				if (Instance->GetOuter() != Target->GetOwner())
+				{
+					Instance->Rename(nullptr, Target->GetOwner(), REN_DontCreateRedirectors | REN_NonTransactional);
+				}
+				Instance->InstanceId = NewId;
+				TargetEntry.ItemInstance = Instance;
 			}
-			break;
-
-		case EOutlawInventorySortMode::ByWeight:
+			else
 			{
-				const float WeightDiff = (A.ItemDef->Weight * A.StackCount) - (B.ItemDef->Weight * B.StackCount);
-				Result = (WeightDiff > 0.0f) ? 1 : (WeightDiff < 0.0f) ? -1 : 0;
+				FOutlawItemWeaponState State;
+				GetWeaponStateById(InstanceId, State);
+				Target->ApplyWeaponState(TargetEntry, State);
 			}
-			break;
+			Target->InventoryList.MarkItemDirty(TargetEntry);
 		}
+	}
 
-		return bDescending ? (Result > 0) : (Result < 0);
-	});
+	if (bWholeEntry)
+	{
+		if (IsGridMode() && Entry->GridX != INDEX_NONE)
+		{
+			ClearOccupancy(Entry->GridX, Entry->GridY, ItemDef->GridWidth, ItemDef->GridHeight);
+		}
+		InventoryList.RemoveEntry(InstanceId);
+	}
+	else
+	{
+		SetEntryStackCount(*Entry, Entry->StackCount - MoveCount);
+	}
 
-	InventoryList.MarkArrayDirty();
 	BroadcastInventoryChanged();
+	Target->BroadcastInventoryChanged();
+
+	// Push both sides out in the same net update rather than whenever each owner's frequency comes round
+	GetOwner()->ForceNetUpdate();
+	if (Target->GetOwner() != GetOwner())
+	{
+		Target->GetOwner()->ForceNetUpdate();
+	}
+
+	return true;
 }
 
-// ── Equipment ───────────────────────────────────────────────────
+TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsByTag(FGameplayTag Tag) const
+{
+	return CopyEntriesInOrder(GetInstanceIdsByTag(Tag));
+}
 
-bool UOutlawInventoryComponent::EquipItem(int32 InstanceId)
+int32 UOutlawInventoryComponent::GetItemCount(const UOutlawItemDefinition* ItemDef) const
+{
+	const FOutlawItemDefStacks* Stacks = StacksByDef.Find(ItemDef);
+	return Stacks ? Stacks->TotalCount : 0;
+}
+
+bool UOutlawInventoryComponent::HasItem(const UOutlawItemDefinition* ItemDef, int32 Count) const
+{
+	return GetItemCount(ItemDef) >= Count;
+}
+
+float UOutlawInventoryComponent::GetCurrentWeight() const
+{
+	return static_cast<float>(CachedWeight);
+}
+
+int32 UOutlawInventoryComponent::GetRemainingSlots() const
+{
+	if (IsGridMode())
+	{
+		return FreeGridCellCount;
+	}
+	return MaxSlots - InventoryList.Entries.Num();
+}
+
+TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsForSlot(FGameplayTag SlotTag) const
+{
+	return CopyEntriesInOrder(GetInstanceIdsForSlot(SlotTag));
+}
+
+TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsByType(EOutlawItemType ItemType) const
+{
+	return CopyEntriesInOrder(GetInstanceIdsByType(ItemType));
+}
+
+TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::FindItemsByRarity(EOutlawItemRarity Rarity) const
+{
+	return CopyEntriesInOrder(GetInstanceIdsByRarity(Rarity));
+}
+
+// ── Batch API ───────────────────────────────────────────────────
+
+bool UOutlawInventoryComponent::AddItems(const TArray<FOutlawItemAddRequest>& Requests, EOutlawInventoryBatchMode Mode, TArray<FOutlawItemBatchResult>& OutResults)
 {
+	OutResults.Reset();
+	OutResults.SetNum(Requests.Num());
+
 	if (!GetOwner()->HasAuthority())
 	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("AddItems called on client (%d requests)."), Requests.Num());
 		return false;
 	}
 
-	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
-	if (!Entry || !Entry->ItemDef)
+	if (RejectWhileLoading(TEXT("AddItems")))
 	{
-		UE_LOG(LogOutlawInventory, Warning, TEXT("EquipItem: Invalid InstanceId %d"), InstanceId);
 		return false;
 	}
 
-	const UOutlawItemDefinition* ItemDef = Entry->ItemDef;
-	if (!ItemDef->bCanBeEquipped)
+	BeginBatch();
+
+	bool bAllApplied = true;
+	for (int32 i = 0; i < Requests.Num(); ++i)
+	{
+		const FOutlawItemAddRequest& Request = Requests[i];
+		FOutlawItemBatchResult& Result = OutResults[i];
+
+		// Instance IDs are handed out sequentially, so everything generated during this AddItem belongs to it
+		const int32 FirstId = NextInstanceId;
+		Result.Applied = AddItem(Request.ItemDef, Request.Count);
+		for (int32 Id = FirstId; Id < NextInstanceId; ++Id)
+		{
+			Result.CreatedInstanceIds.Add(Id);
+		}
+
+		if (Result.Applied < Request.Count)
+		{
+			bAllApplied = false;
+			if (Mode == EOutlawInventoryBatchMode::AllOrNothing)
+			{
+				break;
+			}
+		}
+	}
+
+	if (!bAllApplied && Mode == EOutlawInventoryBatchMode::AllOrNothing)
+	{
+		RollbackBatchAdds();
+		for (FOutlawItemBatchResult& Result : OutResults)
+		{
+			Result.Applied = 0;
+			Result.CreatedInstanceIds.Reset();
+		}
+	}
+
+	EndBatch();
+	return bAllApplied;
+}
+
+bool UOutlawInventoryComponent::RemoveItems(const TArray<FOutlawItemRemoveRequest>& Requests, EOutlawInventoryBatchMode Mode, TArray<FOutlawItemBatchResult>& OutResults)
+{
+	OutResults.Reset();
+	OutResults.SetNum(Requests.Num());
+
+	if (!GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("RemoveItems")))
 	{
-		UE_LOG(LogOutlawInventory, Warning, TEXT("EquipItem: Item '%s' cannot be equipped."), *ItemDef->DisplayName.ToString());
 		return false;
 	}
 
-	FOutlawEquipmentSlotInfo* Slot = FindEquipmentSlot(ItemDef->EquipmentSlotTag);
-	if (!Slot)
+	// Validate everything before touching the inventory; nothing to roll back on failure
+	if (Mode == EOutlawInventoryBatchMode::AllOrNothing)
+	{
+		TMap<int32, int32> NeededByInstance;
+		TMap<const UOutlawItemDefinition*, int32> NeededByDef;
+
+		for (const FOutlawItemRemoveRequest& Request : Requests)
+		{
+			if (Request.Count <= 0)
+			{
+				continue;
+			}
+
+			const UOutlawItemDefinition* ItemDef = Request.ItemDef;
+			if (Request.InstanceId != INDEX_NONE)
+			{
+				const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Request.InstanceId);
+				if (!Entry)
+				{
+					return false;
+				}
+
+				ItemDef = Entry->ItemDef;
+				if ((NeededByInstance.FindOrAdd(Request.InstanceId) += Request.Count) > Entry->StackCount)
+				{
+					return false;
+				}
+			}
+
+			if (!ItemDef || (NeededByDef.FindOrAdd(ItemDef) += Request.Count) > GetItemCount(ItemDef))
+			{
+				return false;
+			}
+		}
+	}
+
+	// Targeted removals first so definition-wide draining can't consume a stack another request names
+	TArray<int32, TInlineAllocator<16>> Order;
+	Order.Reserve(Requests.Num());
+	for (int32 i = 0; i < Requests.Num(); ++i)
+	{
+		if (Requests[i].InstanceId != INDEX_NONE)
+		{
+			Order.Add(i);
+		}
+	}
+	for (int32 i = 0; i < Requests.Num(); ++i)
+	{
+		if (Requests[i].InstanceId == INDEX_NONE)
+		{
+			Order.Add(i);
+		}
+	}
+
+	BeginBatch();
+
+	bool bAllApplied = true;
+	for (const int32 i : Order)
+	{
+		const FOutlawItemRemoveRequest& Request = Requests[i];
+		FOutlawItemBatchResult& Result = OutResults[i];
+		if (Request.Count <= 0)
+		{
+			continue;
+		}
+
+		if (Request.InstanceId != INDEX_NONE)
+		{
+			const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Request.InstanceId);
+			const int32 Available = Entry ? Entry->StackCount : 0;
+			if (Entry && RemoveItem(Request.InstanceId, Request.Count))
+			{
+				Result.Applied = FMath::Min(Request.Count, Available);
+			}
+		}
+		else
+		{
+			Result.Applied = RemoveItemByDef(Request.ItemDef, Request.Count);
+		}
+
+		bAllApplied &= Result.Applied == Request.Count;
+	}
+
+	EndBatch();
+	return bAllApplied;
+}
+
+// ── Native Queries ──────────────────────────────────────────────
+
+namespace
+{
+	template<typename KeyType>
+	TConstArrayView<int32> FindBucket(const TMap<KeyType, TArray<int32>>& Buckets, const KeyType& Key)
+	{
+		const TArray<int32>* Bucket = Buckets.Find(Key);
+		return Bucket ? TConstArrayView<int32>(*Bucket) : TConstArrayView<int32>();
+	}
+}
+
+const FOutlawInventoryEntry* UOutlawInventoryComponent::FindEntry(int32 InstanceId) const
+{
+	return InventoryList.FindEntry(InstanceId);
+}
+
+TConstArrayView<int32> UOutlawInventoryComponent::GetInstanceIdsByType(EOutlawItemType ItemType) const
+{
+	return FindBucket(IdsByType, ItemType);
+}
+
+TConstArrayView<int32> UOutlawInventoryComponent::GetInstanceIdsByRarity(EOutlawItemRarity Rarity) const
+{
+	return FindBucket(IdsByRarity, Rarity);
+}
+
+TConstArrayView<int32> UOutlawInventoryComponent::GetInstanceIdsForSlot(FGameplayTag SlotTag) const
+{
+	return FindBucket(IdsBySlot, SlotTag);
+}
+
+TConstArrayView<int32> UOutlawInventoryComponent::GetInstanceIdsByTag(FGameplayTag Tag) const
+{
+	return FindBucket(IdsByTag, Tag);
+}
+
+TArray<FOutlawInventoryEntry> UOutlawInventoryComponent::CopyEntriesInOrder(TConstArrayView<int32> InstanceIds) const
+{
+	// Buckets are unordered; Blueprint callers have always received entries in inventory order
+	const TArray<FOutlawInventoryEntry>& Entries = InventoryList.Entries;
+
+	TArray<int32, TInlineAllocator<64>> Indices;
+	Indices.Reserve(InstanceIds.Num());
+	for (const int32 Id : InstanceIds)
+	{
+		const int32 Index = InventoryList.IndexOfEntry(Id);
+		if (Index != INDEX_NONE)
+		{
+			Indices.Add(Index);
+		}
+	}
+	Indices.Sort([&Entries](int32 A, int32 B)
+	{
+		return Entries[A].SortOrder != Entries[B].SortOrder ? Entries[A].SortOrder < Entries[B].SortOrder : A < B;
+	});
+
+	TArray<FOutlawInventoryEntry> Result;
+	Result.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		Result.Add(InventoryList.Entries[Index]);
+	}
+	return Result;
+}
+
+// ── Sorting ─────────────────────────────────────────────────────
+
+void UOutlawInventoryComponent::SortInventory(EOutlawInventorySortMode SortMode, bool bDescending)
+{
+	if (!GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("SortInventory")))
+	{
+		return;
+	}
+
+	// Keys are computed once per entry; the comparator only touches integers and floats
+	struct FSortKey
+	{
+		int32 EntryIndex;
+		int32 PreviousOrder;
+		int32 Primary;
+		int32 NameRank;
+		float Weight;
+		bool bHasDef;
+	};
+
+	const bool bNeedsNames = SortMode == EOutlawInventorySortMode::ByName || SortMode == EOutlawInventorySortMode::ByType;
+	if (bNeedsNames)
+	{
+		RefreshNameRanks();
+	}
+
+	// Rarity, type and weight come from the packed hot fields; only name ranks still need the definition pointer
+	const FOutlawInventoryHotFields& Hot = InventoryList.GetHotFields();
+
+	TArray<FSortKey> Keys;
+	Keys.Reserve(InventoryList.Entries.Num());
+	for (int32 i = 0; i < InventoryList.Entries.Num(); ++i)
+	{
+		const FOutlawInventoryEntry& Entry = InventoryList.Entries[i];
+
+		FSortKey& Key = Keys.AddZeroed_GetRef();
+		Key.EntryIndex = i;
+		Key.PreviousOrder = Entry.SortOrder;
+		Key.bHasDef = Hot.HasDef(i);
+		if (!Key.bHasDef)
+		{
+			continue;
+		}
+
+		Key.Primary = SortMode == EOutlawInventorySortMode::ByRarity ? static_cast<int32>(Hot.Rarity[i])
+			: SortMode == EOutlawInventorySortMode::ByType ? static_cast<int32>(Hot.ItemType[i])
+			: 0;
+		Key.NameRank = bNeedsNames ? NameRankCache.FindRef(Entry.ItemDef) : 0;
+		Key.Weight = Hot.UnitWeight[i] * Entry.StackCount;
+	}
+
+	Keys.Sort([SortMode, bDescending](const FSortKey& A, const FSortKey& B)
+	{
+		// Null-def entries sink to the bottom
+		if (A.bHasDef != B.bHasDef)
+		{
+			return A.bHasDef;
+		}
+
+		int32 Result = 0;
+		switch (SortMode)
+		{
+		case EOutlawInventorySortMode::ByName:
+			Result = A.NameRank - B.NameRank;
+			break;
+
+		case EOutlawInventorySortMode::ByRarity:
+			Result = A.Primary - B.Primary;
+			break;
+
+		case EOutlawInventorySortMode::ByType:
+			// Secondary sort by name within same type
+			Result = A.Primary != B.Primary ? A.Primary - B.Primary : A.NameRank - B.NameRank;
+			break;
+
+		case EOutlawInventorySortMode::ByWeight:
+			Result = (A.Weight > B.Weight) ? 1 : (A.Weight < B.Weight) ? -1 : 0;
+			break;
+		}
+
+		if (Result != 0)
+		{
+			return bDescending ? (Result > 0) : (Result < 0);
+		}
+
+		// Equal keys keep their previous relative order
+		return A.PreviousOrder < B.PreviousOrder;
+	});
+
+	// The array itself is left alone: only entries whose position changed are marked for replication
+	for (int32 Position = 0; Position < Keys.Num(); ++Position)
+	{
+		FOutlawInventoryEntry& Entry = InventoryList.Entries[Keys[Position].EntryIndex];
+		if (Entry.SortOrder != Position)
+		{
+			Entry.SortOrder = Position;
+			InventoryList.MarkItemDirty(Entry);
+		}
+	}
+	InventoryList.NextSortOrder = Keys.Num();
+
+	NoteReorder();
+	BroadcastInventoryChanged();
+}
+
+TArray<int32> UOutlawInventoryComponent::GetInstanceIdsInSortOrder() const
+{
+	TArray<int32> Indices;
+	GetEntryIndicesInSortOrder(Indices);
+
+	TArray<int32> Result;
+	Result.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		Result.Add(InventoryList.Entries[Index].InstanceId);
+	}
+	return Result;
+}
+
+void UOutlawInventoryComponent::GetEntryIndicesInSortOrder(TArray<int32>& OutIndices) const
+{
+	const TArray<FOutlawInventoryEntry>& Entries = InventoryList.Entries;
+
+	OutIndices.Reset(Entries.Num());
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		OutIndices.Add(i);
+	}
+
+	OutIndices.Sort([&Entries](int32 A, int32 B)
+	{
+		return Entries[A].SortOrder != Entries[B].SortOrder ? Entries[A].SortOrder < Entries[B].SortOrder : A < B;
+	});
+}
+
+void UOutlawInventoryComponent::RefreshNameRanks()
+{
+	const FString Culture = FInternationalization::Get().GetCurrentCulture()->GetName();
+	bool bStale = Culture != NameRankCulture;
+	if (!bStale)
+	{
+		for (const TPair<const UOutlawItemDefinition*, FOutlawItemDefStacks>& Pair : StacksByDef)
+		{
+			if (!NameRankCache.Contains(Pair.Key))
+			{
+				bStale = true;
+				break;
+			}
+		}
+	}
+
+	if (!bStale)
+	{
+		return;
+	}
+
+	// One locale-aware comparison pass over distinct definitions instead of over every entry pair
+	TArray<const UOutlawItemDefinition*> Defs;
+	StacksByDef.GetKeys(Defs);
+	Defs.Sort([](const UOutlawItemDefinition& A, const UOutlawItemDefinition& B)
+	{
+		return A.DisplayName.CompareTo(B.DisplayName) < 0;
+	});
+
+	NameRankCache.Reset();
+	int32 Rank = 0;
+	for (int32 i = 0; i < Defs.Num(); ++i)
+	{
+		// Equal names share a rank so they tie and keep their previous order
+		if (i > 0 && Defs[i - 1]->DisplayName.CompareTo(Defs[i]->DisplayName) != 0)
+		{
+			++Rank;
+		}
+		NameRankCache.Add(Defs[i], Rank);
+	}
+	NameRankCulture = Culture;
+}
+
+// ── Equipment ───────────────────────────────────────────────────
+
+bool UOutlawInventoryComponent::EquipItem(int32 InstanceId)
+{
+	if (!GetOwner()->HasAuthority())
+	{
+		return PredictEquipItem(InstanceId);
+	}
+
+	if (RejectWhileLoading(TEXT("EquipItem")))
+	{
+		return false;
+	}
+
+	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!Entry || !Entry->ItemDef)
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("EquipItem: Invalid InstanceId %d"), InstanceId);
+		return false;
+	}
+
+	const UOutlawItemDefinition* ItemDef = Entry->ItemDef;
+	if (!ItemDef->bCanBeEquipped)
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("EquipItem: Item '%s' cannot be equipped."), *ItemDef->DisplayName.ToString());
+		return false;
+	}
+
+	FOutlawEquipmentSlotInfo* Slot = FindEquipmentSlot(ItemDef->EquipmentSlotTag);
+	if (!Slot)
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("EquipItem: No equipment slot '%s' configured."), *ItemDef->EquipmentSlotTag.ToString());
+		return false;
+	}
+
+	// Unequip current item in that slot if occupied
+	if (Slot->EquippedItemInstanceId != INDEX_NONE)
+	{
+		UnequipItem(Slot->SlotTag);
+	}
+
+	Slot->EquippedItemInstanceId = InstanceId;
+	SlotIndexByInstanceId.Add(InstanceId, static_cast<int32>(Slot - EquipmentSlots.GetData()));
+	MarkSaveDirty(InstanceId);
+
+	// Grant ability set via ASC
+	if (ItemDef->GrantedAbilitySet)
+	{
+		UAbilitySystemComponent* ASC = GetASC();
+		if (ASC)
+		{
+			ItemDef->GrantedAbilitySet->GiveToAbilitySystem(ASC, GetOwner(), Slot->GrantedHandles);
+		}
+	}
+
+	// Inline weapon state: the equipped weapon gets a real instance to hold its ability handles
+	if (bInlineWeaponState && !Entry->ItemInstance && ItemDef->IsWeapon())
+	{
+		Entry->ItemInstance = CreateItemInstance(Entry->ItemDef, InstanceId);
+		Entry->ItemInstance->InitFromWeaponState(Entry->WeaponState);
+		InventoryList.MarkItemDirty(*Entry);
+
+		// Give back what UnequipItem revoked from the previous instance
+		if (UAbilitySystemComponent* ASC = GetASC())
+		{
+			Entry->ItemInstance->GrantInstalledModAbilities(ASC);
+			if (Entry->bInlineAffixEffectsGranted)
+			{
+				Entry->ItemInstance->GrantAffixEffects(ASC);
+			}
+		}
+		Entry->bInlineAffixEffectsGranted = false;
+	}
+
+	// Notify weapon manager if this is a weapon with an instance
+	if (Entry->ItemInstance)
+	{
+		if (UOutlawWeaponManagerComponent* WeaponMgr = GetWeaponManager())
+		{
+			WeaponMgr->OnWeaponEquipped(Entry->ItemInstance, Slot->SlotTag);
+		}
+	}
+
+	OnItemEquipped.Broadcast(ItemDef, Slot->SlotTag);
+	BroadcastInventoryChanged();
+	return true;
+}
+
+bool UOutlawInventoryComponent::UnequipItem(FGameplayTag SlotTag)
+{
+	if (!GetOwner()->HasAuthority())
+	{
+		return PredictUnequipItem(SlotTag);
+	}
+
+	if (RejectWhileLoading(TEXT("UnequipItem")))
+	{
+		return false;
+	}
+
+	FOutlawEquipmentSlotInfo* Slot = FindEquipmentSlot(SlotTag);
+	if (!Slot || Slot->EquippedItemInstanceId == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Slot->EquippedItemInstanceId);
+	const UOutlawItemDefinition* ItemDef = Entry ? Entry->ItemDef : nullptr;
+
+	// Notify weapon manager before revoking
+	if (Entry && Entry->ItemInstance)
+	{
+		if (UOutlawWeaponManagerComponent* WeaponMgr = GetWeaponManager())
+		{
+			WeaponMgr->OnWeaponUnequipped(Entry->ItemInstance, SlotTag);
+		}
+	}
+
+	// Revoke ability set
+	UAbilitySystemComponent* ASC = GetASC();
+	if (ASC)
+	{
+		Slot->GrantedHandles.RevokeFromASC(ASC);
+	}
+
+	// Inline weapon state: fold the instance back into the entry (ammo etc. moved while equipped) and drop it
+	if (bInlineWeaponState && Entry && Entry->ItemInstance)
+	{
+		// Nothing could revoke the instance's mod abilities or affix effects once it is gone
+		if (ASC)
+		{
+			Entry->ItemInstance->RevokeInstalledModAbilities(ASC);
+			Entry->bInlineAffixEffectsGranted = Entry->ItemInstance->HasAffixEffectsGranted();
+			Entry->ItemInstance->RevokeAffixEffects(ASC);
+		}
+		Entry->ItemInstance->CaptureWeaponState(Entry->WeaponState);
+		Entry->ItemInstance = nullptr;
+		InventoryList.MarkItemDirty(*Entry);
+	}
+
+	MarkSaveDirty(Slot->EquippedItemInstanceId);
+	SlotIndexByInstanceId.Remove(Slot->EquippedItemInstanceId);
+	Slot->EquippedItemInstanceId = INDEX_NONE;
+
+	if (ItemDef)
+	{
+		OnItemUnequipped.Broadcast(ItemDef, SlotTag);
+	}
+	BroadcastInventoryChanged();
+	return true;
+}
+
+UOutlawItemDefinition* UOutlawInventoryComponent::GetEquippedItem(FGameplayTag SlotTag) const
+{
+	const int32 EquippedId = GetEquippedInstanceId(SlotTag);
+	if (EquippedId == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(EquippedId);
+	return Entry ? const_cast<UOutlawItemDefinition*>(Entry->ItemDef.Get()) : nullptr;
+}
+
+bool UOutlawInventoryComponent::IsSlotOccupied(FGameplayTag SlotTag) const
+{
+	return GetEquippedInstanceId(SlotTag) != INDEX_NONE;
+}
+
+FGameplayTag UOutlawInventoryComponent::GetEquippedSlotOf(int32 InstanceId) const
+{
+	if (!bEquipmentSlotIndexBuilt)
+	{
+		RebuildEquipmentSlotIndex();
+	}
+
+	// Client-predicted equips and unequips override the replicated slots (a handful of entries at most)
+	for (const TPair<int32, int32>& Predicted : PredictedSlotIds)
+	{
+		if (Predicted.Value == InstanceId)
+		{
+			return EquipmentSlots[Predicted.Key].SlotTag;
+		}
+	}
+
+	const int32* SlotIdx = SlotIndexByInstanceId.Find(InstanceId);
+	if (!SlotIdx || PredictedSlotIds.Contains(*SlotIdx))
+	{
+		return FGameplayTag();
+	}
+	return EquipmentSlots[*SlotIdx].SlotTag;
+}
+
+bool UOutlawInventoryComponent::IsItemEquipped(int32 InstanceId) const
+{
+	return GetEquippedSlotOf(InstanceId).IsValid();
+}
+
+void UOutlawInventoryComponent::OnRep_EquipmentSlots()
+{
+	RebuildEquipmentSlotIndex();
+
+	// Confirmed equips/unequips can stop overriding the slots now that the server state has arrived
+	if (PendingPredictions.Num() > 0)
+	{
+		PendingPredictions.RemoveAll([](const FPendingPrediction& Pending)
+		{
+			return Pending.bAccepted && Pending.Op.Type != EOutlawInventoryPredictedOpType::Move;
+		});
+		ReapplyPredictions();
+	}
+}
+
+// ── Use ─────────────────────────────────────────────────────────
+
+bool UOutlawInventoryComponent::UseItem(int32 InstanceId)
+{
+	if (!GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("UseItem")))
+	{
+		return false;
+	}
+
+	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!Entry || !Entry->ItemDef)
+	{
+		return false;
+	}
+
+	const UOutlawItemDefinition* ItemDef = Entry->ItemDef;
+	if (!ItemDef->UseAbility)
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("UseItem: Item '%s' has no UseAbility."), *ItemDef->DisplayName.ToString());
+		return false;
+	}
+
+	UAbilitySystemComponent* ASC = GetASC();
+	if (!ASC)
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("UseItem: No ASC found on owning actor."));
+		return false;
+	}
+
+	if (bPreGrantUseAbilities)
+	{
+		// Already granted while this definition is held; using is just an activation
+		const FGameplayAbilitySpecHandle Handle = FindOrGrantUseAbility(ItemDef, ASC);
+		const FGameplayAbilitySpec* Spec = Handle.IsValid() ? ASC->FindAbilitySpecFromHandle(Handle) : nullptr;
+		if (Spec && !Spec->IsActive())
+		{
+			if (!ASC->TryActivateAbility(Handle))
+			{
+				return false;
+			}
+
+			// Consuming the last one releases the spec; ReleaseUseAbility lets the running activation finish first
+			RemoveItem(InstanceId, 1);
+			OnItemUsed.Broadcast(ItemDef);
+			return true;
+		}
+
+		// Not tracked (mode enabled after the item arrived), or an earlier use is still running and an instanced
+		// ability cannot activate twice on one spec: fall back to a transient grant so every use gets its own spec
+	}
+
+	// Grant and try to activate the use ability
+	FGameplayAbilitySpec AbilitySpec(ItemDef->UseAbility, 1, INDEX_NONE, GetOwner());
+	const FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(AbilitySpec);
+
+	if (ASC->TryActivateAbility(Handle))
+	{
+		// Consume one from the stack
+		RemoveItem(InstanceId, 1);
+		OnItemUsed.Broadcast(ItemDef);
+
+		// Clean up the transient ability after it ends
+		ASC->SetRemoveAbilityOnEnd(Handle);
+		return true;
+	}
+
+	// Activation failed — remove the transient ability
+	ASC->ClearAbility(Handle);
+	return false;
+}
+
+void UOutlawInventoryComponent::AcquireUseAbility(const UOutlawItemDefinition* ItemDef)
+{
+	if (!bPreGrantUseAbilities || !ItemDef->UseAbility || !GetOwner() || !GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	FGrantedUseAbility& Granted = GrantedUseAbilities.FindOrAdd(ItemDef->UseAbility.Get());
+	if (Granted.RefCount++ > 0)
+	{
+		return;
+	}
+
+	// No ASC yet (e.g. before possession): FindOrGrantUseAbility grants on first use instead
+	if (UAbilitySystemComponent* ASC = GetASC())
+	{
+		Granted.Handle = ASC->GiveAbility(FGameplayAbilitySpec(ItemDef->UseAbility, 1, INDEX_NONE, GetOwner()));
+	}
+}
+
+void UOutlawInventoryComponent::ReleaseUseAbility(const UOutlawItemDefinition* ItemDef)
+{
+	if (!ItemDef->UseAbility)
+	{
+		return;
+	}
+
+	const TObjectKey<UClass> AbilityKey(ItemDef->UseAbility.Get());
+	FGrantedUseAbility* Granted = GrantedUseAbilities.Find(AbilityKey);
+	if (!Granted || --Granted->RefCount > 0)
+	{
+		return;
+	}
+
+	if (Granted->Handle.IsValid())
+	{
+		if (UAbilitySystemComponent* ASC = GetASC())
+		{
+			// Removes immediately if idle, otherwise once the activation that consumed the last item ends
+			ASC->SetRemoveAbilityOnEnd(Granted->Handle);
+		}
+	}
+
+	GrantedUseAbilities.Remove(AbilityKey);
+}
+
+FGameplayAbilitySpecHandle UOutlawInventoryComponent::FindOrGrantUseAbility(const UOutlawItemDefinition* ItemDef, UAbilitySystemComponent* ASC)
+{
+	FGrantedUseAbility* Granted = GrantedUseAbilities.Find(ItemDef->UseAbility.Get());
+	if (!Granted)
+	{
+		return FGameplayAbilitySpecHandle();
+	}
+
+	// Granted late if the ASC was missing at acquire time, or again if something cleared the spec
+	if (!Granted->Handle.IsValid() || !ASC->FindAbilitySpecFromHandle(Granted->Handle))
+	{
+		Granted->Handle = ASC->GiveAbility(FGameplayAbilitySpec(ItemDef->UseAbility, 1, INDEX_NONE, GetOwner()));
+	}
+
+	return Granted->Handle;
+}
+
+// ── Save/Load ───────────────────────────────────────────────────
+
+FOutlawInventorySaveData UOutlawInventoryComponent::SaveInventory()
+{
+	RefreshSaveRecords();
+
+	FOutlawInventorySaveData SaveData;
+
+	// Save in display order so a sorted inventory loads back sorted
+	TArray<int32> SortedIndices;
+	GetEntryIndicesInSortOrder(SortedIndices);
+	SaveData.Items.Reserve(SortedIndices.Num());
+
+	for (const int32 EntryIndex : SortedIndices)
+	{
+		if (const FCachedSaveRecord* Cached = SaveRecordCache.Find(InventoryList.Entries[EntryIndex].InstanceId))
+		{
+			SaveData.Items.Add(Cached->Record);
+		}
+	}
+
+	return SaveData;
+}
+
+FOutlawInventorySaveDelta UOutlawInventoryComponent::SaveInventoryDelta()
+{
+	RefreshSaveRecords();
+
+	FOutlawInventorySaveDelta Delta;
+
+	// Upserts in display order, so entries new to the base append in the order they are shown
+	TArray<int32> SortedIndices;
+	GetEntryIndicesInSortOrder(SortedIndices);
+
+	for (const int32 EntryIndex : SortedIndices)
+	{
+		const int32 InstanceId = InventoryList.Entries[EntryIndex].InstanceId;
+		if (SaveChangedIds.Contains(InstanceId))
+		{
+			Delta.Upserts.Add(SaveRecordCache.FindChecked(InstanceId).Record);
+		}
+		if (bSaveOrderDirty && SaveRecordCache.Contains(InstanceId))
+		{
+			Delta.Order.Add(InstanceId);
+		}
+	}
+
+	Delta.RemovedInstanceIds = SaveRemovedIds.Array();
+	return Delta;
+}
+
+void UOutlawInventoryComponent::CommitSaveBaseline()
+{
+	SaveChangedIds.Reset();
+	SaveRemovedIds.Reset();
+	bSaveOrderDirty = false;
+}
+
+void UOutlawInventoryComponent::LoadInventory(const FOutlawInventorySaveData& Data, bool bForceSynchronous)
+{
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	// Supersede any load still waiting on assets
+	if (PendingLoadHandle.IsValid())
+	{
+		PendingLoadHandle->CancelHandle();
+		PendingLoadHandle.Reset();
+	}
+
+	const double GatherStart = FPlatformTime::Seconds();
+
+	// Every distinct asset the save references, requested as one batch
+	TSet<FSoftObjectPath> UniquePaths;
+	for (const FOutlawInventoryItemSaveEntry& SaveEntry : Data.Items)
+	{
+		UniquePaths.Add(SaveEntry.ItemDefPath);
+		for (const FOutlawSavedAffix& SavedAffix : SaveEntry.SavedAffixes)
+		{
+			UniquePaths.Add(SavedAffix.AffixDefPath);
+		}
+		for (const FSoftObjectPath& GemPath : SaveEntry.SavedSocketedGems)
+		{
+			UniquePaths.Add(GemPath);
+		}
+		UniquePaths.Add(SaveEntry.SavedModTier1);
+		UniquePaths.Add(SaveEntry.SavedModTier2);
+	}
+	UniquePaths.Remove(FSoftObjectPath());
+
+	TArray<FSoftObjectPath> PathsToLoad = UniquePaths.Array();
+
+	PendingLoadData = Data;
+	PendingLoadStats = FOutlawInventoryLoadStats();
+	PendingLoadStats.UniqueAssetCount = PathsToLoad.Num();
+	PendingLoadStats.GatherSeconds = static_cast<float>(FPlatformTime::Seconds() - GatherStart);
+	PendingLoadRequestTime = FPlatformTime::Seconds();
+	bLoadPending = true;
+
+	const UWorld* World = GetWorld();
+	const bool bSynchronous = bForceSynchronous || !World || !World->IsGameWorld() || PathsToLoad.IsEmpty();
+	PendingLoadStats.bSynchronous = bSynchronous;
+
+	FStreamableManager& Streamable = UAssetManager::GetStreamableManager();
+	if (bSynchronous)
+	{
+		if (!PathsToLoad.IsEmpty())
+		{
+			PendingLoadHandle = Streamable.RequestSyncLoad(MoveTemp(PathsToLoad));
+		}
+		OnLoadInventoryAssetsReady();
+		return;
+	}
+
+	PendingLoadHandle = Streamable.RequestAsyncLoad(MoveTemp(PathsToLoad),
+		FStreamableDelegate::CreateUObject(this, &UOutlawInventoryComponent::OnLoadInventoryAssetsReady));
+
+	// Everything already resident: the delegate ran inside RequestAsyncLoad, before the handle was stored
+	if (!bLoadPending)
+	{
+		PendingLoadHandle.Reset();
+	}
+}
+
+TArray<uint8> UOutlawInventoryComponent::SaveInventoryBinary()
+{
+	TArray<uint8> Bytes;
+	SaveInventory().SaveToBinary(Bytes);
+	return Bytes;
+}
+
+bool UOutlawInventoryComponent::LoadInventoryBinary(const TArray<uint8>& Bytes, bool bForceSynchronous)
+{
+	FOutlawInventorySaveData Data;
+	if (!Data.LoadFromBinary(Bytes))
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("LoadInventoryBinary: could not decode %d bytes"), Bytes.Num());
+		return false;
+	}
+
+	LoadInventory(Data, bForceSynchronous);
+	return true;
+}
+
+bool UOutlawInventoryComponent::IsLoadPending() const
+{
+	return bLoadPending;
+}
+
+bool UOutlawInventoryComponent::RejectWhileLoading(const TCHAR* Operation) const
+{
+	if (!bLoadPending)
+	{
+		return false;
+	}
+
+	// The pending load replaces the whole inventory, so anything applied now would be silently lost
+	UE_LOG(LogOutlawInventory, Warning, TEXT("%s refused: LoadInventory is still waiting on assets."), Operation);
+	return true;
+}
+
+bool UOutlawInventoryComponent::ExportItemRecord(int32 InstanceId, FOutlawInventoryItemSaveEntry& OutRecord) const
+{
+	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!Entry || !Entry->ItemDef)
+	{
+		return false;
+	}
+
+	OutRecord = BuildSaveRecord(*Entry, GetEquippedSlotOf(InstanceId));
+	return true;
+}
+
+int32 UOutlawInventoryComponent::AddItemFromRecord(const FOutlawInventoryItemSaveEntry& Record)
+{
+	if (!GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("AddItemFromRecord called on client. Item: %s"), *Record.ItemDefPath.ToString());
+		return 0;
+	}
+
+	// One item at a time from external storage: usually already resident, so no async batch like LoadInventory
+	auto Resolve = [](const FSoftObjectPath& Path) -> UObject*
+	{
+		return Path.IsValid() ? Path.TryLoad() : nullptr;
+	};
+
+	UOutlawItemDefinition* ItemDef = Cast<UOutlawItemDefinition>(Resolve(Record.ItemDefPath));
+	if (!ItemDef)
+	{
+		UE_LOG(LogOutlawInventory, Warning, TEXT("AddItemFromRecord: could not load '%s'"), *Record.ItemDefPath.ToString());
+		return 0;
+	}
+
+	// Instance IDs are handed out sequentially, so everything generated during this AddItem belongs to it
+	const int32 FirstId = NextInstanceId;
+	const int32 Added = AddItem(ItemDef, Record.StackCount);
+
+	if (Added > 0 && ItemDef->IsWeapon())
+	{
+		const FOutlawItemWeaponState State = MakeWeaponStateFromRecord(ItemDef, Record, Resolve);
+		for (int32 Id = FirstId; Id < NextInstanceId; ++Id)
+		{
+			if (FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Id))
+			{
+				ApplyWeaponState(*Entry, State);
+				InventoryList.MarkItemDirty(*Entry);
+				MarkSaveDirty(Id);
+			}
+		}
+	}
+
+	return Added;
+}
+
+void UOutlawInventoryComponent::OnLoadInventoryAssetsReady()
+{
+	if (!bLoadPending)
+	{
+		return;
+	}
+
+	// Lifted first: the unequip/equip calls below are mutations themselves
+	bLoadPending = false;
+
+	PendingLoadStats.AssetLoadSeconds = static_cast<float>(FPlatformTime::Seconds() - PendingLoadRequestTime);
+	const double MaterializeStart = FPlatformTime::Seconds();
+
+	// Everything below resolves already-loaded objects; nothing here touches the disk
+	auto Resolve = [](const FSoftObjectPath& Path) -> UObject*
+	{
+		return Path.IsValid() ? Path.ResolveObject() : nullptr;
+	};
+
+	// Unequip all slots first
+	for (FOutlawEquipmentSlotInfo& Slot : EquipmentSlots)
+	{
+		if (Slot.EquippedItemInstanceId != INDEX_NONE)
+		{
+			UnequipItem(Slot.SlotTag);
+		}
+	}
+
+	// Clear current inventory
+	InventoryList.ResetEntries();
+
+	if (IsGridMode())
+	{
+		ResetOccupancyGrid();
+	}
+
+	// Keep saved InstanceIds so later deltas still match this save. Fresh IDs start past every saved one.
+	for (const FOutlawInventoryItemSaveEntry& SaveEntry : PendingLoadData.Items)
+	{
+		NextInstanceId = FMath::Max(NextInstanceId, SaveEntry.InstanceId + 1);
+	}
+
+	// Restore items
+	TArray<TPair<int32, FGameplayTag>> ItemsToEquip;
+
+	for (const FOutlawInventoryItemSaveEntry& SaveEntry : PendingLoadData.Items)
+	{
+		UOutlawItemDefinition* ItemDef = Cast<UOutlawItemDefinition>(Resolve(SaveEntry.ItemDefPath));
+		if (!ItemDef)
+		{
+			UE_LOG(LogOutlawInventory, Warning, TEXT("LoadInventory: Failed to load item at path '%s'"), *SaveEntry.ItemDefPath.ToString());
+			continue;
+		}
+
+		const bool bKeepSavedId = SaveEntry.InstanceId != INDEX_NONE && !InventoryList.FindEntry(SaveEntry.InstanceId);
+		const int32 NewInstanceId = bKeepSavedId ? SaveEntry.InstanceId : GenerateInstanceId();
+		const int32 EntryIdx = InventoryList.AddEntry(ItemDef, SaveEntry.StackCount, NewInstanceId, SaveEntry.GridX, SaveEntry.GridY);
+
+		if (IsGridMode() && SaveEntry.GridX != INDEX_NONE)
+		{
+			SetOccupancy(SaveEntry.GridX, SaveEntry.GridY, ItemDef->GridWidth, ItemDef->GridHeight, NewInstanceId);
+		}
+
+		// Restore weapon state if this is a weapon
+		if (ItemDef->IsWeapon())
+		{
+			ApplyWeaponState(InventoryList.Entries[EntryIdx], MakeWeaponStateFromRecord(ItemDef, SaveEntry, Resolve));
+		}
+
+		if (SaveEntry.EquippedSlotTag.IsValid())
+		{
+			ItemsToEquip.Add(TPair<int32, FGameplayTag>(NewInstanceId, SaveEntry.EquippedSlotTag));
+		}
+
+		++PendingLoadStats.ItemCount;
+	}
+
+	const double EquipStart = FPlatformTime::Seconds();
+	PendingLoadStats.MaterializeSeconds = static_cast<float>(EquipStart - MaterializeStart);
+
+	// Re-equip items that were equipped at save time
+	for (const auto& Pair : ItemsToEquip)
+	{
+		EquipItem(Pair.Key);
+	}
+
+	PendingLoadStats.EquipSeconds = static_cast<float>(FPlatformTime::Seconds() - EquipStart);
+
+	// The loaded state is the new save baseline: prime every record so the next save re-encodes nothing
+	SaveRecordCache.Reset();
+	RefreshSaveRecords();
+	CommitSaveBaseline();
+
+	// Entries now hold strong references to their assets
+	PendingLoadHandle.Reset();
+	PendingLoadData = FOutlawInventorySaveData();
+
+	LastLoadStats = PendingLoadStats;
+	UE_LOG(LogOutlawInventory, Log, TEXT("LoadInventory: %d items, %d assets (%s): gather %.2f ms, assets %.2f ms, materialize %.2f ms, equip %.2f ms"),
+		LastLoadStats.ItemCount, LastLoadStats.UniqueAssetCount, LastLoadStats.bSynchronous ? TEXT("sync") : TEXT("async"),
+		LastLoadStats.GatherSeconds * 1000.0f, LastLoadStats.AssetLoadSeconds * 1000.0f,
+		LastLoadStats.MaterializeSeconds * 1000.0f, LastLoadStats.EquipSeconds * 1000.0f);
+
+	BroadcastInventoryChanged();
+	OnInventoryLoaded.Broadcast();
+}
+
+// ── Item Instance API ────────────────────────────────────────────
+
+UOutlawItemInstance* UOutlawInventoryComponent::GetItemInstance(FGameplayTag SlotTag) const
+{
+	const int32 EquippedId = GetEquippedInstanceId(SlotTag);
+	if (EquippedId == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(EquippedId);
+	return Entry ? Entry->ItemInstance : nullptr;
+}
+
+UOutlawItemInstance* UOutlawInventoryComponent::GetItemInstanceById(int32 InstanceId) const
+{
+	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	return Entry ? Entry->ItemInstance : nullptr;
+}
+
+bool UOutlawInventoryComponent::GetWeaponStateById(int32 InstanceId, FOutlawItemWeaponState& OutState) const
+{
+	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!Entry || !Entry->ItemDef || !Entry->ItemDef->IsWeapon())
+	{
+		return false;
+	}
+
+	if (Entry->ItemInstance)
+	{
+		Entry->ItemInstance->CaptureWeaponState(OutState);
+	}
+	else
+	{
+		OutState = Entry->WeaponState;
+	}
+	return true;
+}
+
+bool UOutlawInventoryComponent::RollItemAffixes(int32 InstanceId, int32 ItemLevel, int64 Seed)
+{
+	if (!GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("RollItemAffixes")))
+	{
+		return false;
+	}
+
+	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!Entry || !Entry->ItemDef || !Entry->ItemDef->IsWeapon())
+	{
+		return false;
+	}
+
+	const UOutlawARPGWeaponData* ARPGData = Entry->ItemDef->ARPGWeaponData;
+	if (!ARPGData || !ARPGData->AffixPool)
+	{
+		return false;
+	}
+
+	if (Entry->ItemInstance)
+	{
+		Entry->ItemInstance->RollAffixes(ItemLevel, Seed);
+	}
+	else
+	{
+		FOutlawItemWeaponState& State = Entry->WeaponState;
+		UOutlawItemInstance::RollAffixesInto(Entry->ItemDef, ItemLevel, Seed, State.Affixes, State.AffixSeed);
+		State.AffixItemLevel = ItemLevel;
+		InventoryList.MarkItemDirty(*Entry);
+	}
+
+	NotifyItemChanged(InstanceId);
+	return true;
+}
+
+// ── Private Helpers ─────────────────────────────────────────────
+
+UOutlawItemInstance* UOutlawInventoryComponent::CreateItemInstance(UOutlawItemDefinition* ItemDef, int32 InstanceId)
+{
+	if (!ItemDef || !ItemDef->IsWeapon())
+	{
+		return nullptr;
+	}
+
+	UOutlawItemInstance* Instance = NewObject<UOutlawItemInstance>(GetOwner());
+	Instance->ItemDef = ItemDef;
+	Instance->InstanceId = InstanceId;
+	Instance->InitFromWeaponState(MakeDefaultWeaponState(ItemDef));
+	return Instance;
+}
+
+FOutlawItemWeaponState UOutlawInventoryComponent::MakeDefaultWeaponState(const UOutlawItemDefinition* ItemDef)
+{
+	FOutlawItemWeaponState State;
+
+	// Initialize shooter state
+	if (ItemDef->ShooterWeaponData)
+	{
+		State.CurrentAmmo = ItemDef->ShooterWeaponData->MagazineSize;
+	}
+
+	// Initialize ARPG state — copy default socket layout
+	if (ItemDef->ARPGWeaponData)
+	{
+		State.SocketSlots = ItemDef->ARPGWeaponData->DefaultSocketLayout;
+	}
+
+	return State;
+}
+
+FOutlawItemWeaponState UOutlawInventoryComponent::MakeWeaponStateFromRecord(const UOutlawItemDefinition* ItemDef,
+	const FOutlawInventoryItemSaveEntry& Record, TFunctionRef<UObject*(const FSoftObjectPath&)> Resolve)
+{
+	FOutlawItemWeaponState State = MakeDefaultWeaponState(ItemDef);
+	State.CurrentAmmo = Record.CurrentAmmo;
+	State.Quality = Record.Quality;
+
+	// Restore affixes
+	State.Affixes.Reset();
+	for (const FOutlawSavedAffix& SavedAffix : Record.SavedAffixes)
+	{
+		UOutlawAffixDefinition* AffixDef = Cast<UOutlawAffixDefinition>(Resolve(SavedAffix.AffixDefPath));
+		if (AffixDef)
+		{
+			FOutlawItemAffix Affix;
+			Affix.AffixDef = AffixDef;
+			Affix.RolledValue = SavedAffix.RolledValue;
+			Affix.Slot = static_cast<EOutlawAffixSlot>(SavedAffix.Slot);
+			State.Affixes.Add(Affix);
+		}
+	}
+
+	// Restore socketed gems
+	for (int32 i = 0; i < Record.SavedSocketedGems.Num() && i < State.SocketSlots.Num(); ++i)
+	{
+		if (UOutlawSkillGemDefinition* GemDef = Cast<UOutlawSkillGemDefinition>(Resolve(Record.SavedSocketedGems[i])))
+		{
+			State.SocketSlots[i].SocketedGem = GemDef;
+		}
+	}
+
+	// Restore mods
+	if (Record.SavedModTier1.IsValid())
+	{
+		State.InstalledModTier1 = Cast<UOutlawWeaponModDefinition>(Resolve(Record.SavedModTier1));
+	}
+	if (Record.SavedModTier2.IsValid())
+	{
+		State.InstalledModTier2 = Cast<UOutlawWeaponModDefinition>(Resolve(Record.SavedModTier2));
+	}
+
+	State.AffixSeed = Record.AffixSeed;
+	State.AffixItemLevel = Record.AffixItemLevel;
+
+	return State;
+}
+
+void UOutlawInventoryComponent::ApplyWeaponState(FOutlawInventoryEntry& Entry, const FOutlawItemWeaponState& State)
+{
+	if (Entry.ItemInstance)
+	{
+		Entry.ItemInstance->InitFromWeaponState(State);
+	}
+	else if (bInlineWeaponState)
+	{
+		Entry.WeaponState = State;
+	}
+	else
+	{
+		Entry.ItemInstance = CreateItemInstance(Entry.ItemDef, Entry.InstanceId);
+		Entry.ItemInstance->InitFromWeaponState(State);
+	}
+}
+
+void UOutlawInventoryComponent::InitWeaponEntry(FOutlawInventoryEntry& Entry)
+{
+	if (!Entry.ItemDef || !Entry.ItemDef->IsWeapon())
+	{
+		return;
+	}
+
+	if (bInlineWeaponState)
+	{
+		Entry.WeaponState = MakeDefaultWeaponState(Entry.ItemDef);
+	}
+	else
+	{
+		Entry.ItemInstance = CreateItemInstance(Entry.ItemDef, Entry.InstanceId);
+	}
+}
+
+UOutlawWeaponManagerComponent* UOutlawInventoryComponent::GetWeaponManager() const
+{
+	AActor* Owner = GetOwner();
+	return Owner ? Owner->FindComponentByClass<UOutlawWeaponManagerComponent>() : nullptr;
+}
+
+UAbilitySystemComponent* UOutlawInventoryComponent::GetASC() const
+{
+	AActor* Owner = GetOwner();
+	if (!Owner)
+	{
+		return nullptr;
+	}
+
+	// Try the owner actor first (works for characters that implement IAbilitySystemInterface)
+	if (const IAbilitySystemInterface* ASI = Cast<IAbilitySystemInterface>(Owner))
+	{
+		return ASI->GetAbilitySystemComponent();
+	}
+
+	// Try the pawn's player state (common in multiplayer setups like this project)
+	if (const APawn* Pawn = Cast<APawn>(Owner))
+	{
+		if (const APlayerState* PS = Pawn->GetPlayerState())
+		{
+			if (const IAbilitySystemInterface* ASI = Cast<IAbilitySystemInterface>(PS))
+			{
+				return ASI->GetAbilitySystemComponent();
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+FOutlawEquipmentSlotInfo* UOutlawInventoryComponent::FindEquipmentSlot(FGameplayTag SlotTag)
+{
+	const int32 SlotIdx = FindEquipmentSlotIndex(SlotTag);
+	return SlotIdx != INDEX_NONE ? &EquipmentSlots[SlotIdx] : nullptr;
+}
+
+const FOutlawEquipmentSlotInfo* UOutlawInventoryComponent::FindEquipmentSlot(FGameplayTag SlotTag) const
+{
+	const int32 SlotIdx = FindEquipmentSlotIndex(SlotTag);
+	return SlotIdx != INDEX_NONE ? &EquipmentSlots[SlotIdx] : nullptr;
+}
+
+int32 UOutlawInventoryComponent::FindEquipmentSlotIndex(FGameplayTag SlotTag) const
+{
+	if (!bEquipmentSlotIndexBuilt)
+	{
+		RebuildEquipmentSlotIndex();
+	}
+
+	const int32* SlotIdx = SlotIndexByTag.Find(SlotTag);
+	if (!SlotIdx)
+	{
+		return INDEX_NONE;
+	}
+
+	// Guard against the array having been edited without a rebuild
+	if (!EquipmentSlots.IsValidIndex(*SlotIdx) || EquipmentSlots[*SlotIdx].SlotTag != SlotTag)
+	{
+		RebuildEquipmentSlotIndex();
+		SlotIdx = SlotIndexByTag.Find(SlotTag);
+		return SlotIdx ? *SlotIdx : INDEX_NONE;
+	}
+
+	return *SlotIdx;
+}
+
+void UOutlawInventoryComponent::RebuildEquipmentSlotIndex() const
+{
+	SlotIndexByTag.Reset();
+	SlotIndexByInstanceId.Reset();
+
+	for (int32 SlotIdx = 0; SlotIdx < EquipmentSlots.Num(); ++SlotIdx)
+	{
+		const FOutlawEquipmentSlotInfo& Slot = EquipmentSlots[SlotIdx];
+
+		// First slot wins on duplicate tags, matching the old linear scan
+		SlotIndexByTag.FindOrAdd(Slot.SlotTag, SlotIdx);
+		if (Slot.EquippedItemInstanceId != INDEX_NONE)
+		{
+			SlotIndexByInstanceId.FindOrAdd(Slot.EquippedItemInstanceId, SlotIdx);
+		}
+	}
+
+	bEquipmentSlotIndexBuilt = true;
+}
+
+void UOutlawInventoryComponent::BroadcastInventoryChanged()
+{
+	// Inside AddItems/RemoveItems: announce once when the batch closes
+	if (BatchDepth > 0)
+	{
+		bBatchBroadcastPending = true;
+		return;
+	}
+
+	// Client grid stays current through the per-entry Restamp/Unstamp callbacks
+	VerifyCachedTotals();
+	OnInventoryChanged.Broadcast();
+}
+
+// ── Cached Totals ───────────────────────────────────────────────
+
+void UOutlawInventoryComponent::AccountEntry(FOutlawInventoryEntry& Entry)
+{
+	NoteBatchChange(Entry);
+
+	Entry.AccountedItemDef = Entry.ItemDef;
+	Entry.AccountedStackCount = Entry.StackCount;
+
+	const UOutlawItemDefinition* ItemDef = Entry.AccountedItemDef;
+	if (!ItemDef)
+	{
+		return;
+	}
+
+	CachedWeight += static_cast<double>(ItemDef->Weight) * Entry.AccountedStackCount;
+
+	FOutlawItemDefStacks& Stacks = StacksByDef.FindOrAdd(ItemDef);
+	Stacks.InstanceIds.Add(Entry.InstanceId);
+	if (Stacks.InstanceIds.Num() == 1)
+	{
+		AcquireUseAbility(ItemDef);
+	}
+	Stacks.TotalCount += Entry.AccountedStackCount;
+	if (Entry.AccountedStackCount < ItemDef->MaxStackSize)
+	{
+		Stacks.OpenStackIds.Add(Entry.InstanceId);
+	}
+
+	IndexEntryQueries(Entry.InstanceId, ItemDef);
+}
+
+void UOutlawInventoryComponent::UnaccountEntry(FOutlawInventoryEntry& Entry)
+{
+	NoteBatchChange(Entry);
+
+	if (const UOutlawItemDefinition* ItemDef = Entry.AccountedItemDef)
+	{
+		CachedWeight -= static_cast<double>(ItemDef->Weight) * Entry.AccountedStackCount;
+
+		if (FOutlawItemDefStacks* Stacks = StacksByDef.Find(ItemDef))
+		{
+			Stacks->InstanceIds.Remove(Entry.InstanceId);
+			Stacks->OpenStackIds.Remove(Entry.InstanceId);
+			Stacks->TotalCount -= Entry.AccountedStackCount;
+			if (Stacks->InstanceIds.Num() == 0)
+			{
+				StacksByDef.Remove(ItemDef);
+				ReleaseUseAbility(ItemDef);
+			}
+		}
+
+		UnindexEntryQueries(Entry.InstanceId, ItemDef);
+	}
+
+	Entry.AccountedItemDef = nullptr;
+	Entry.AccountedStackCount = 0;
+}
+
+void UOutlawInventoryComponent::ReaccountEntry(FOutlawInventoryEntry& Entry)
+{
+	if (Entry.AccountedItemDef == Entry.ItemDef && Entry.AccountedStackCount == Entry.StackCount)
+	{
+		return;
+	}
+
+	NoteBatchChange(Entry);
+
+	if (Entry.AccountedItemDef != Entry.ItemDef || !Entry.ItemDef)
+	{
+		UnaccountEntry(Entry);
+		AccountEntry(Entry);
+		return;
+	}
+
+	// Same definition, only the stack count moved — adjust in place to keep stack order stable
+	const UOutlawItemDefinition* ItemDef = Entry.ItemDef;
+	const int32 Delta = Entry.StackCount - Entry.AccountedStackCount;
+	CachedWeight += static_cast<double>(ItemDef->Weight) * Delta;
+
+	FOutlawItemDefStacks& Stacks = StacksByDef.FindChecked(ItemDef);
+	Stacks.TotalCount += Delta;
+
+	const bool bWasOpen = Entry.AccountedStackCount < ItemDef->MaxStackSize;
+	const bool bIsOpen = Entry.StackCount < ItemDef->MaxStackSize;
+	if (bWasOpen && !bIsOpen)
+	{
+		Stacks.OpenStackIds.Remove(Entry.InstanceId);
+	}
+	else if (!bWasOpen && bIsOpen)
+	{
+		Stacks.OpenStackIds.Add(Entry.InstanceId);
+	}
+
+	Entry.AccountedStackCount = Entry.StackCount;
+}
+
+void UOutlawInventoryComponent::IndexEntryQueries(int32 InstanceId, const UOutlawItemDefinition* ItemDef)
+{
+	IdsByType.FindOrAdd(ItemDef->ItemType).Add(InstanceId);
+	IdsByRarity.FindOrAdd(ItemDef->Rarity).Add(InstanceId);
+
+	if (ItemDef->bCanBeEquipped)
+	{
+		IdsBySlot.FindOrAdd(ItemDef->EquipmentSlotTag).Add(InstanceId);
+	}
+
+	for (const FGameplayTag& Tag : ItemDef->ItemTags.GetGameplayTagParents())
+	{
+		IdsByTag.FindOrAdd(Tag).Add(InstanceId);
+	}
+}
+
+void UOutlawInventoryComponent::UnindexEntryQueries(int32 InstanceId, const UOutlawItemDefinition* ItemDef)
+{
+	auto RemoveFromBucket = [InstanceId](auto& Buckets, const auto& Key)
+	{
+		if (TArray<int32>* Bucket = Buckets.Find(Key))
+		{
+			Bucket->RemoveSingleSwap(InstanceId, EAllowShrinking::No);
+			if (Bucket->IsEmpty())
+			{
+				Buckets.Remove(Key);
+			}
+		}
+	};
+
+	RemoveFromBucket(IdsByType, ItemDef->ItemType);
+	RemoveFromBucket(IdsByRarity, ItemDef->Rarity);
+
+	if (ItemDef->bCanBeEquipped)
+	{
+		RemoveFromBucket(IdsBySlot, ItemDef->EquipmentSlotTag);
+	}
+
+	for (const FGameplayTag& Tag : ItemDef->ItemTags.GetGameplayTagParents())
+	{
+		RemoveFromBucket(IdsByTag, Tag);
+	}
+}
+
+void UOutlawInventoryComponent::SetEntryStackCount(FOutlawInventoryEntry& Entry, int32 NewStackCount)
+{
+	Entry.StackCount = NewStackCount;
+	ReaccountEntry(Entry);
+	NoteEntryChange(Entry.InstanceId, OutlawInventoryChange::Changed);
+	InventoryList.MarkItemDirty(Entry);
+}
+
+void UOutlawInventoryComponent::VerifyCachedTotals() const
+{
+#if DO_CHECK
+	double RecomputedWeight = 0.0;
+	const FOutlawInventoryHotFields& Hot = InventoryList.GetHotFields();
+	for (int32 i = 0; i < InventoryList.Entries.Num(); ++i)
+	{
+		RecomputedWeight += static_cast<double>(Hot.UnitWeight[i]) * InventoryList.Entries[i].StackCount;
+	}
+	ensureMsgf(FMath::IsNearlyEqual(RecomputedWeight, CachedWeight, 0.01),
+		TEXT("Inventory cached weight %.3f does not match recomputed %.3f"), CachedWeight, RecomputedWeight);
+
+	if (IsGridMode())
+	{
+		int32 RecomputedFreeCells = 0;
+		for (const int32 Cell : OccupancyGrid)
+		{
+			if (Cell == INDEX_NONE)
+			{
+				++RecomputedFreeCells;
+			}
+		}
+		ensureMsgf(RecomputedFreeCells == FreeGridCellCount,
+			TEXT("Inventory cached free cells %d does not match recomputed %d"), FreeGridCellCount, RecomputedFreeCells);
+
+		for (int32 Y = 0; Y < InventoryGridHeight; ++Y)
+		{
+			for (int32 X = 0; X < InventoryGridWidth; ++X)
+			{
+				const bool bIdOccupied = OccupancyGrid[GridIndex(X, Y)] != INDEX_NONE;
+				ensureMsgf(bIdOccupied == OccupancyMask.IsOccupied(X, Y),
+					TEXT("Inventory occupancy mask disagrees with ID grid at (%d, %d)"), X, Y);
+			}
+		}
+	}
+#endif
+}
+
+int32 UOutlawInventoryComponent::GenerateInstanceId()
+{
+	return NextInstanceId++;
+}
+
+// ── Client Replication ──────────────────────────────────────────
+
+bool UOutlawInventoryComponent::RestampReplicatedEntry(FOutlawInventoryEntry& Entry)
+{
+	if (!IsGridMode())
+	{
+		return false;
+	}
+
+	// Initial replication can arrive before BeginPlay sizes the grid; stamp everything received so far
+	if (!IsOccupancyGridSized())
+	{
+		RebuildOccupancyGrid();
+		return false;
+	}
+
+	const bool bPlaced = Entry.ItemDef && Entry.GridX != INDEX_NONE;
+	const int32 W = bPlaced ? Entry.ItemDef->GridWidth : 0;
+	const int32 H = bPlaced ? Entry.ItemDef->GridHeight : 0;
+	if (Entry.StampedGridX == (bPlaced ? Entry.GridX : INDEX_NONE) && Entry.StampedGridY == (bPlaced ? Entry.GridY : INDEX_NONE)
+		&& Entry.StampedGridW == W && Entry.StampedGridH == H)
+	{
+		return false;
+	}
+
+	const bool bWasStamped = Entry.StampedGridX != INDEX_NONE;
+	UnstampReplicatedEntry(Entry);
+
+	if (bPlaced)
+	{
+		SetOccupancy(Entry.GridX, Entry.GridY, W, H, Entry.InstanceId);
+		Entry.StampedGridX = Entry.GridX;
+		Entry.StampedGridY = Entry.GridY;
+		Entry.StampedGridW = W;
+		Entry.StampedGridH = H;
+	}
+
+	return bWasStamped;
+}
+
+void UOutlawInventoryComponent::UnstampReplicatedEntry(FOutlawInventoryEntry& Entry)
+{
+	// Only cells still holding this ID: another entry processed earlier in the same update may already own them
+	if (Entry.StampedGridX != INDEX_NONE && IsGridMode() && IsOccupancyGridSized())
+	{
+		ClearOccupancyOf(Entry.StampedGridX, Entry.StampedGridY, Entry.StampedGridW, Entry.StampedGridH, Entry.InstanceId);
+	}
+
+	Entry.StampedGridX = INDEX_NONE;
+	Entry.StampedGridY = INDEX_NONE;
+	Entry.StampedGridW = 0;
+	Entry.StampedGridH = 0;
+}
+
+void UOutlawInventoryComponent::FlushReplicatedChanges()
+{
+	if (!bReplicatedChangePending)
+	{
+		return;
+	}
+
+	bReplicatedChangePending = false;
+
+	// Server state just overwrote some entries; put unacknowledged predictions back on top
+	if (PendingPredictions.Num() > 0 || PredictedEntryIds.Num() > 0)
+	{
+		ReapplyPredictions();
+	}
+
+	BroadcastInventoryChanged();
+}
+
+// ── Client Prediction ───────────────────────────────────────────
+
+bool UOutlawInventoryComponent::HasPendingPredictions() const
+{
+	return PendingPredictions.Num() > 0;
+}
+
+bool UOutlawInventoryComponent::PredictMoveItem(int32 InstanceId, int32 NewX, int32 NewY)
+{
+	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!GetOwner()->HasLocalNetOwner() || !Entry || !Entry->ItemDef || !CanPlaceItemAtIgnoring(Entry->ItemDef, NewX, NewY, InstanceId))
+	{
+		return false;
+	}
+
+	FOutlawInventoryPredictedOp Op;
+	Op.Type = EOutlawInventoryPredictedOpType::Move;
+	Op.InstanceId = InstanceId;
+	Op.GridX = NewX;
+	Op.GridY = NewY;
+	QueuePrediction(Op);
+
+	Entry->GridX = NewX;
+	Entry->GridY = NewY;
+	RestampReplicatedEntry(*Entry);
+	PredictedEntryIds.Add(InstanceId);
+	NoteEntryChange(InstanceId, OutlawInventoryChange::Moved);
+
+	BroadcastInventoryChanged();
+	return true;
+}
+
+bool UOutlawInventoryComponent::PredictEquipItem(int32 InstanceId)
+{
+	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+	if (!GetOwner()->HasLocalNetOwner() || !Entry || !Entry->ItemDef || !Entry->ItemDef->bCanBeEquipped)
+	{
+		return false;
+	}
+
+	const int32 SlotIdx = FindEquipmentSlotIndex(Entry->ItemDef->EquipmentSlotTag);
+	if (SlotIdx == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FOutlawInventoryPredictedOp Op;
+	Op.Type = EOutlawInventoryPredictedOpType::Equip;
+	Op.InstanceId = InstanceId;
+	Op.SlotTag = EquipmentSlots[SlotIdx].SlotTag;
+	QueuePrediction(Op);
+
+	PredictedSlotIds.Add(SlotIdx, InstanceId);
+
+	BroadcastInventoryChanged();
+	return true;
+}
+
+bool UOutlawInventoryComponent::PredictUnequipItem(FGameplayTag SlotTag)
+{
+	const int32 SlotIdx = FindEquipmentSlotIndex(SlotTag);
+	if (!GetOwner()->HasLocalNetOwner() || SlotIdx == INDEX_NONE || GetEquippedInstanceId(SlotTag) == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FOutlawInventoryPredictedOp Op;
+	Op.Type = EOutlawInventoryPredictedOpType::Unequip;
+	Op.SlotTag = SlotTag;
+	QueuePrediction(Op);
+
+	PredictedSlotIds.Add(SlotIdx, INDEX_NONE);
+
+	BroadcastInventoryChanged();
+	return true;
+}
+
+void UOutlawInventoryComponent::QueuePrediction(FOutlawInventoryPredictedOp Op)
+{
+	Op.PredictionKey = NextPredictionKey++;
+	PendingPredictions.Add({ Op });
+	UnsentPredictions.Add(Op);
+
+	if (bPredictionSendScheduled)
+	{
+		return;
+	}
+
+	// One RPC per frame however many drags land in it
+	UWorld* World = GetWorld();
+	if (!World)
 	{
-		UE_LOG(LogOutlawInventory, Warning, TEXT("EquipItem: No equipment slot '%s' configured."), *ItemDef->EquipmentSlotTag.ToString());
-		return false;
+		SendPredictedOps();
+		return;
 	}
 
-	// Unequip current item in that slot if occupied
-	if (Slot->EquippedItemInstanceId != INDEX_NONE)
+	bPredictionSendScheduled = true;
+	World->GetTimerManager().SetTimerForNextTick(this, &UOutlawInventoryComponent::SendPredictedOps);
+}
+
+void UOutlawInventoryComponent::SendPredictedOps()
+{
+	bPredictionSendScheduled = false;
+
+	if (UnsentPredictions.IsEmpty())
 	{
-		UnequipItem(Slot->SlotTag);
+		return;
 	}
 
-	Slot->EquippedItemInstanceId = InstanceId;
+	ServerApplyPredictedOps(UnsentPredictions);
+	UnsentPredictions.Reset();
+}
 
-	// Grant ability set via ASC
-	if (ItemDef->GrantedAbilitySet)
+void UOutlawInventoryComponent::ServerApplyPredictedOps_Implementation(const TArray<FOutlawInventoryPredictedOp>& Ops)
+{
+	// A frame of drags is a handful of ops; anything past this is refused rather than trusted
+	constexpr int32 MaxOpsPerBatch = 64;
+
+	TArray<int32> RejectedKeys;
+	int32 LastKey = 0;
+
+	BeginBatch();
+
+	for (int32 OpIdx = 0; OpIdx < Ops.Num(); ++OpIdx)
 	{
-		UAbilitySystemComponent* ASC = GetASC();
-		if (ASC)
+		const FOutlawInventoryPredictedOp& Op = Ops[OpIdx];
+		LastKey = FMath::Max(LastKey, Op.PredictionKey);
+
+		bool bApplied = false;
+		if (OpIdx < MaxOpsPerBatch)
 		{
-			ItemDef->GrantedAbilitySet->GiveToAbilitySystem(ASC, GetOwner(), Slot->GrantedHandles);
+			switch (Op.Type)
+			{
+			case EOutlawInventoryPredictedOpType::Move:
+				bApplied = MoveItem(Op.InstanceId, Op.GridX, Op.GridY);
+				break;
+			case EOutlawInventoryPredictedOpType::Equip:
+				bApplied = EquipItem(Op.InstanceId);
+				break;
+			case EOutlawInventoryPredictedOpType::Unequip:
+				bApplied = UnequipItem(Op.SlotTag);
+				break;
+			}
+		}
+
+		if (!bApplied)
+		{
+			RejectedKeys.Add(Op.PredictionKey);
 		}
 	}
 
-	// Notify weapon manager if this is a weapon with an instance
-	if (Entry->ItemInstance)
+	EndBatch();
+
+	// Replicate the result this frame too, so the client waits as little as possible between ack and state
+	GetOwner()->ForceNetUpdate();
+	ClientAckPredictedOps(LastKey, RejectedKeys);
+}
+
+void UOutlawInventoryComponent::ClientAckPredictedOps_Implementation(int32 LastKey, const TArray<int32>& RejectedKeys)
+{
+	// Newest first: an accepted op superseded by a later accepted op on the same entry or slot has nothing left to show
+	TSet<int32> SettledEntries;
+	TSet<FGameplayTag> SettledSlots;
+
+	for (int32 Idx = PendingPredictions.Num() - 1; Idx >= 0; --Idx)
 	{
-		if (UOutlawWeaponManagerComponent* WeaponMgr = GetWeaponManager())
+		FPendingPrediction& Pending = PendingPredictions[Idx];
+		const FOutlawInventoryPredictedOp& Op = Pending.Op;
+		if (Op.PredictionKey > LastKey)
 		{
-			WeaponMgr->OnWeaponEquipped(Entry->ItemInstance, Slot->SlotTag);
+			continue;
+		}
+
+		// Rejected ops roll back by dropping out of the replay; accepted ones from an earlier ack have had their chance to replicate
+		if (Pending.bAccepted || RejectedKeys.Contains(Op.PredictionKey))
+		{
+			PendingPredictions.RemoveAt(Idx);
+			continue;
+		}
+
+		bool bSuperseded = false;
+		if (Op.Type == EOutlawInventoryPredictedOpType::Move)
+		{
+			SettledEntries.Add(Op.InstanceId, &bSuperseded);
+		}
+		else
+		{
+			SettledSlots.Add(Op.SlotTag, &bSuperseded);
+		}
+
+		if (bSuperseded || MatchesServerState(Op))
+		{
+			PendingPredictions.RemoveAt(Idx);
+			continue;
 		}
+
+		Pending.bAccepted = true;
 	}
 
-	OnItemEquipped.Broadcast(ItemDef, Slot->SlotTag);
+	ReapplyPredictions();
 	BroadcastInventoryChanged();
-	return true;
 }
 
-bool UOutlawInventoryComponent::UnequipItem(FGameplayTag SlotTag)
+void UOutlawInventoryComponent::ReceiveServerEntryState(FOutlawInventoryEntry& Entry)
 {
-	if (!GetOwner()->HasAuthority())
+	Entry.ServerGridX = Entry.GridX;
+	Entry.ServerGridY = Entry.GridY;
+
+	if (PendingPredictions.Num() > 0)
 	{
-		return false;
+		const int32 InstanceId = Entry.InstanceId;
+		PendingPredictions.RemoveAll([InstanceId](const FPendingPrediction& Pending)
+		{
+			return Pending.bAccepted && Pending.Op.Type == EOutlawInventoryPredictedOpType::Move && Pending.Op.InstanceId == InstanceId;
+		});
 	}
+}
 
-	FOutlawEquipmentSlotInfo* Slot = FindEquipmentSlot(SlotTag);
-	if (!Slot || Slot->EquippedItemInstanceId == INDEX_NONE)
+void UOutlawInventoryComponent::ReapplyPredictions()
+{
+	// Grid: every entry showing a prediction restarts from its server position, then pending moves replay in key order
+	TSet<int32> MovedIds;
+	for (const FPendingPrediction& Pending : PendingPredictions)
 	{
-		return false;
+		if (Pending.Op.Type == EOutlawInventoryPredictedOpType::Move)
+		{
+			MovedIds.Add(Pending.Op.InstanceId);
+		}
 	}
 
-	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Slot->EquippedItemInstanceId);
-	const UOutlawItemDefinition* ItemDef = Entry ? Entry->ItemDef : nullptr;
-
-	// Notify weapon manager before revoking
-	if (Entry && Entry->ItemInstance)
+	for (const int32 InstanceId : PredictedEntryIds.Union(MovedIds))
 	{
-		if (UOutlawWeaponManagerComponent* WeaponMgr = GetWeaponManager())
+		FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
+		if (!Entry)
 		{
-			WeaponMgr->OnWeaponUnequipped(Entry->ItemInstance, SlotTag);
+			continue;
+		}
+
+		int32 X = Entry->ServerGridX;
+		int32 Y = Entry->ServerGridY;
+		for (const FPendingPrediction& Pending : PendingPredictions)
+		{
+			if (Pending.Op.Type == EOutlawInventoryPredictedOpType::Move && Pending.Op.InstanceId == InstanceId)
+			{
+				X = Pending.Op.GridX;
+				Y = Pending.Op.GridY;
+			}
+		}
+
+		if (Entry->GridX != X || Entry->GridY != Y)
+		{
+			Entry->GridX = X;
+			Entry->GridY = Y;
+			RestampReplicatedEntry(*Entry);
+			NoteEntryChange(InstanceId, OutlawInventoryChange::Moved);
 		}
 	}
+	PredictedEntryIds = MoveTemp(MovedIds);
 
-	// Revoke ability set
-	UAbilitySystemComponent* ASC = GetASC();
-	if (ASC)
+	// Equipment: the slot overlay is just the pending equips/unequips, later ones winning
+	PredictedSlotIds.Reset();
+	for (const FPendingPrediction& Pending : PendingPredictions)
 	{
-		Slot->GrantedHandles.RevokeFromASC(ASC);
+		if (Pending.Op.Type == EOutlawInventoryPredictedOpType::Move)
+		{
+			continue;
+		}
+
+		const int32 SlotIdx = FindEquipmentSlotIndex(Pending.Op.SlotTag);
+		if (SlotIdx != INDEX_NONE)
+		{
+			PredictedSlotIds.Add(SlotIdx, Pending.Op.Type == EOutlawInventoryPredictedOpType::Equip ? Pending.Op.InstanceId : INDEX_NONE);
+		}
 	}
+}
 
-	Slot->EquippedItemInstanceId = INDEX_NONE;
+bool UOutlawInventoryComponent::MatchesServerState(const FOutlawInventoryPredictedOp& Op) const
+{
+	if (Op.Type == EOutlawInventoryPredictedOpType::Move)
+	{
+		const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Op.InstanceId);
+		return !Entry || (Entry->ServerGridX == Op.GridX && Entry->ServerGridY == Op.GridY);
+	}
 
-	if (ItemDef)
+	const int32 SlotIdx = FindEquipmentSlotIndex(Op.SlotTag);
+	if (SlotIdx == INDEX_NONE)
 	{
-		OnItemUnequipped.Broadcast(ItemDef, SlotTag);
+		return true;
 	}
-	BroadcastInventoryChanged();
-	return true;
+
+	const int32 ExpectedId = Op.Type == EOutlawInventoryPredictedOpType::Equip ? Op.InstanceId : INDEX_NONE;
+	return EquipmentSlots[SlotIdx].EquippedItemInstanceId == ExpectedId;
 }
 
-UOutlawItemDefinition* UOutlawInventoryComponent::GetEquippedItem(FGameplayTag SlotTag) const
+int32 UOutlawInventoryComponent::GetEquippedInstanceId(FGameplayTag SlotTag) const
 {
-	const FOutlawEquipmentSlotInfo* Slot = FindEquipmentSlot(SlotTag);
-	if (!Slot || Slot->EquippedItemInstanceId == INDEX_NONE)
+	const int32 SlotIdx = FindEquipmentSlotIndex(SlotTag);
+	if (SlotIdx == INDEX_NONE)
 	{
-		return nullptr;
+		return INDEX_NONE;
 	}
 
-	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Slot->EquippedItemInstanceId);
-	return Entry ? const_cast<UOutlawItemDefinition*>(Entry->ItemDef.Get()) : nullptr;
-}
+	// Clients show their own unacknowledged equips/unequips over the replicated slots
+	if (const int32* Predicted = PredictedSlotIds.Find(SlotIdx))
+	{
+		return *Predicted;
+	}
 
-bool UOutlawInventoryComponent::IsSlotOccupied(FGameplayTag SlotTag) const
-{
-	const FOutlawEquipmentSlotInfo* Slot = FindEquipmentSlot(SlotTag);
-	return Slot && Slot->EquippedItemInstanceId != INDEX_NONE;
+	return EquipmentSlots[SlotIdx].EquippedItemInstanceId;
 }
 
-// ── Use ─────────────────────────────────────────────────────────
+// ── Change Sets ─────────────────────────────────────────────────
 
-bool UOutlawInventoryComponent::UseItem(int32 InstanceId)
+void UOutlawInventoryComponent::NotifyItemChanged(int32 InstanceId)
 {
-	if (!GetOwner()->HasAuthority())
+	if (InventoryList.FindEntry(InstanceId))
 	{
-		return false;
+		NoteEntryChange(InstanceId, OutlawInventoryChange::Changed);
 	}
+}
 
-	FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
-	if (!Entry || !Entry->ItemDef)
+void UOutlawInventoryComponent::NoteEntryChange(int32 InstanceId, uint8 ChangeFlags)
+{
+	using namespace OutlawInventoryChange;
+
+	uint8* Pending = PendingEntryChanges.Find(InstanceId);
+	if (!Pending)
 	{
-		return false;
+		// First note this frame: anything but an add means the entry was already there
+		const uint8 Initial = (ChangeFlags & Added) ? 0 : (ExistedAtStart | ExistsNow);
+		Pending = &PendingEntryChanges.Add(InstanceId, Initial);
 	}
-
-	const UOutlawItemDefinition* ItemDef = Entry->ItemDef;
-	if (!ItemDef->UseAbility)
+	*Pending |= ChangeFlags;
+	if (ChangeFlags & Removed)
 	{
-		UE_LOG(LogOutlawInventory, Warning, TEXT("UseItem: Item '%s' has no UseAbility."), *ItemDef->DisplayName.ToString());
-		return false;
+		*Pending &= ~ExistsNow;
 	}
+	if (ChangeFlags & Added)
+	{
+		*Pending |= ExistsNow;
+	}
+	ScheduleChangeSetFlush();
 
-	UAbilitySystemComponent* ASC = GetASC();
-	if (!ASC)
+	if (ChangeFlags & OutlawInventoryChange::Removed)
 	{
-		UE_LOG(LogOutlawInventory, Warning, TEXT("UseItem: No ASC found on owning actor."));
-		return false;
+		if (GetOwner() && GetOwner()->HasAuthority())
+		{
+			SaveRecordCache.Remove(InstanceId);
+			SaveDirtyIds.Remove(InstanceId);
+			SaveChangedIds.Remove(InstanceId);
+			SaveRemovedIds.Add(InstanceId);
+		}
+	}
+	else
+	{
+		// A reused ID is a new record, not a removal
+		if ((ChangeFlags & OutlawInventoryChange::Added) && GetOwner() && GetOwner()->HasAuthority())
+		{
+			SaveRemovedIds.Remove(InstanceId);
+		}
+		MarkSaveDirty(InstanceId);
 	}
+}
 
-	// Grant and try to activate the use ability
-	FGameplayAbilitySpec AbilitySpec(ItemDef->UseAbility, 1, INDEX_NONE, GetOwner());
-	const FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(AbilitySpec);
+void UOutlawInventoryComponent::NoteReorder()
+{
+	bPendingReorder = true;
+	ScheduleChangeSetFlush();
 
-	if (ASC->TryActivateAbility(Handle))
+	if (GetOwner() && GetOwner()->HasAuthority())
 	{
-		// Consume one from the stack
-		RemoveItem(InstanceId, 1);
-		OnItemUsed.Broadcast(ItemDef);
+		bSaveOrderDirty = true;
+	}
+}
 
-		// Clean up the transient ability after it ends
-		ASC->SetRemoveAbilityOnEnd(Handle);
-		return true;
+void UOutlawInventoryComponent::ScheduleChangeSetFlush()
+{
+	if (bChangeSetFlushScheduled)
+	{
+		return;
 	}
 
-	// Activation failed — remove the transient ability
-	ASC->ClearAbility(Handle);
-	return false;
-}
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
 
-// ── Save/Load ───────────────────────────────────────────────────
+	bChangeSetFlushScheduled = true;
+	World->GetTimerManager().SetTimerForNextTick(this, &UOutlawInventoryComponent::FlushChangeSet);
+}
 
-FOutlawInventorySaveData UOutlawInventoryComponent::SaveInventory() const
+void UOutlawInventoryComponent::FlushChangeSet()
 {
-	FOutlawInventorySaveData SaveData;
+	bChangeSetFlushScheduled = false;
 
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
+	FOutlawInventoryChangeSet ChangeSet;
+	ChangeSet.bReordered = bPendingReorder;
+	bPendingReorder = false;
+
+	for (const TPair<int32, uint8>& Pair : PendingEntryChanges)
 	{
-		if (!Entry.ItemDef)
+		const uint8 Flags = Pair.Value;
+		const bool bExistedAtStart = (Flags & OutlawInventoryChange::ExistedAtStart) != 0;
+		const bool bExistsNow = (Flags & OutlawInventoryChange::ExistsNow) != 0;
+
+		// Added and removed within the frame: listeners never saw it
+		if (!bExistedAtStart && !bExistsNow)
 		{
 			continue;
 		}
 
-		FOutlawInventoryItemSaveEntry SaveEntry;
-		SaveEntry.ItemDefPath = FSoftObjectPath(Entry.ItemDef);
-		SaveEntry.StackCount = Entry.StackCount;
-		SaveEntry.GridX = Entry.GridX;
-		SaveEntry.GridY = Entry.GridY;
-
-		// Check if this item is currently equipped
-		for (const FOutlawEquipmentSlotInfo& Slot : EquipmentSlots)
+		if (!bExistsNow)
 		{
-			if (Slot.EquippedItemInstanceId == Entry.InstanceId)
-			{
-				SaveEntry.EquippedSlotTag = Slot.SlotTag;
-				break;
-			}
+			ChangeSet.Removed.Add(Pair.Key);
+			continue;
 		}
 
-		// Save weapon instance state
-		if (Entry.ItemInstance)
+		if (!bExistedAtStart)
 		{
-			UOutlawItemInstance* Inst = Entry.ItemInstance;
-			SaveEntry.CurrentAmmo = Inst->CurrentAmmo;
-			SaveEntry.Quality = Inst->Quality;
-
-			// Save affixes
-			for (const FOutlawItemAffix& Affix : Inst->Affixes)
-			{
-				FOutlawSavedAffix SavedAffix;
-				SavedAffix.AffixDefPath = FSoftObjectPath(Affix.AffixDef);
-				SavedAffix.RolledValue = Affix.RolledValue;
-				SavedAffix.Slot = static_cast<uint8>(Affix.Slot);
-				SaveEntry.SavedAffixes.Add(SavedAffix);
-			}
-
-			// Save socketed gems
-			for (const FOutlawSocketSlot& Socket : Inst->SocketSlots)
-			{
-				SaveEntry.SavedSocketedGems.Add(Socket.SocketedGem ? FSoftObjectPath(Socket.SocketedGem) : FSoftObjectPath());
-			}
-
-			// Save mods
-			if (Inst->InstalledModTier1)
-			{
-				SaveEntry.SavedModTier1 = FSoftObjectPath(Inst->InstalledModTier1);
-			}
-			if (Inst->InstalledModTier2)
-			{
-				SaveEntry.SavedModTier2 = FSoftObjectPath(Inst->InstalledModTier2);
-			}
+			ChangeSet.Added.Add(Pair.Key);
+			continue;
 		}
 
-		SaveData.Items.Add(SaveEntry);
-	}
-
-	return SaveData;
-}
-
-void UOutlawInventoryComponent::LoadInventory(const FOutlawInventorySaveData& Data)
-{
-	if (!GetOwner()->HasAuthority())
-	{
-		return;
-	}
+		// Removed and added back under the same ID: a different item now, so report both
+		if (Flags & OutlawInventoryChange::Removed)
+		{
+			ChangeSet.Removed.Add(Pair.Key);
+			ChangeSet.Added.Add(Pair.Key);
+			continue;
+		}
 
-	// Unequip all slots first
-	for (FOutlawEquipmentSlotInfo& Slot : EquipmentSlots)
-	{
-		if (Slot.EquippedItemInstanceId != INDEX_NONE)
+		if (Flags & OutlawInventoryChange::Changed)
 		{
-			UnequipItem(Slot.SlotTag);
+			ChangeSet.Changed.Add(Pair.Key);
+		}
+		if (Flags & OutlawInventoryChange::Moved)
+		{
+			ChangeSet.Moved.Add(Pair.Key);
 		}
 	}
+	PendingEntryChanges.Reset();
 
-	// Clear current inventory
-	InventoryList.Entries.Reset();
-	InventoryList.MarkArrayDirty();
-
-	if (IsGridMode())
+	if (ChangeSet.IsEmpty())
 	{
-		OccupancyGrid.Init(INDEX_NONE, InventoryGridWidth * InventoryGridHeight);
+		return;
 	}
 
-	// Restore items
-	TArray<TPair<int32, FGameplayTag>> ItemsToEquip;
+	OnInventoryChangeSetNative.Broadcast(ChangeSet);
+	OnInventoryChangeSet.Broadcast(ChangeSet);
+}
 
-	for (const FOutlawInventoryItemSaveEntry& SaveEntry : Data.Items)
+// ── Save Records ────────────────────────────────────────────────
+
+void UOutlawInventoryComponent::RefreshSaveRecords()
+{
+	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
 	{
-		UOutlawItemDefinition* ItemDef = Cast<UOutlawItemDefinition>(SaveEntry.ItemDefPath.TryLoad());
-		if (!ItemDef)
+		if (!Entry.ItemDef)
 		{
-			UE_LOG(LogOutlawInventory, Warning, TEXT("LoadInventory: Failed to load item at path '%s'"), *SaveEntry.ItemDefPath.ToString());
 			continue;
 		}
 
-		const int32 NewInstanceId = GenerateInstanceId();
-		const int32 EntryIdx = InventoryList.AddEntry(ItemDef, SaveEntry.StackCount, NewInstanceId, SaveEntry.GridX, SaveEntry.GridY);
-
-		if (IsGridMode() && SaveEntry.GridX != INDEX_NONE)
+		// Instance state (ammo, affixes, gems, mods) can change without touching the entry
+		const uint32 InstanceRevision = Entry.ItemInstance ? Entry.ItemInstance->GetStateRevision() : 0;
+		const FCachedSaveRecord* Cached = SaveRecordCache.Find(Entry.InstanceId);
+		if (Cached && Cached->InstanceRevision == InstanceRevision && !SaveDirtyIds.Contains(Entry.InstanceId))
 		{
-			SetOccupancy(SaveEntry.GridX, SaveEntry.GridY, ItemDef->GridWidth, ItemDef->GridHeight, NewInstanceId);
+			continue;
 		}
 
-		// Restore weapon instance if this is a weapon
-		if (ItemDef->IsWeapon())
-		{
-			UOutlawItemInstance* Inst = CreateItemInstance(ItemDef, NewInstanceId);
-			InventoryList.Entries[EntryIdx].ItemInstance = Inst;
+		FCachedSaveRecord& Fresh = SaveRecordCache.FindOrAdd(Entry.InstanceId);
+		Fresh.Record = BuildSaveRecord(Entry, GetEquippedSlotOf(Entry.InstanceId));
+		Fresh.InstanceRevision = InstanceRevision;
+		SaveChangedIds.Add(Entry.InstanceId);
+	}
 
-			Inst->CurrentAmmo = SaveEntry.CurrentAmmo;
-			Inst->Quality = SaveEntry.Quality;
+	SaveDirtyIds.Reset();
+}
 
-			// Restore affixes
-			Inst->Affixes.Reset();
-			for (const FOutlawSavedAffix& SavedAffix : SaveEntry.SavedAffixes)
-			{
-				UOutlawAffixDefinition* AffixDef = Cast<UOutlawAffixDefinition>(SavedAffix.AffixDefPath.TryLoad());
-				if (AffixDef)
-				{
-					FOutlawItemAffix Affix;
-					Affix.AffixDef = AffixDef;
-					Affix.RolledValue = SavedAffix.RolledValue;
-					Affix.Slot = static_cast<EOutlawAffixSlot>(SavedAffix.Slot);
-					Inst->Affixes.Add(Affix);
-				}
-			}
+FOutlawInventoryItemSaveEntry UOutlawInventoryComponent::BuildSaveRecord(const FOutlawInventoryEntry& Entry, FGameplayTag EquippedSlotTag) const
+{
+	FOutlawInventoryItemSaveEntry SaveEntry;
+	SaveEntry.ItemDefPath = FSoftObjectPath(Entry.ItemDef);
+	SaveEntry.StackCount = Entry.StackCount;
+	SaveEntry.InstanceId = Entry.InstanceId;
+	SaveEntry.GridX = Entry.GridX;
+	SaveEntry.GridY = Entry.GridY;
+	SaveEntry.EquippedSlotTag = EquippedSlotTag;
 
-			// Restore socketed gems
-			for (int32 i = 0; i < SaveEntry.SavedSocketedGems.Num() && i < Inst->SocketSlots.Num(); ++i)
-			{
-				if (SaveEntry.SavedSocketedGems[i].IsValid())
-				{
-					UOutlawSkillGemDefinition* GemDef = Cast<UOutlawSkillGemDefinition>(SaveEntry.SavedSocketedGems[i].TryLoad());
-					if (GemDef)
-					{
-						Inst->SocketSlots[i].SocketedGem = GemDef;
-					}
-				}
-			}
+	// Save weapon state (live instance while one exists, otherwise the inline copy)
+	FOutlawItemWeaponState State;
+	bool bHasWeaponState = true;
+	if (Entry.ItemInstance)
+	{
+		Entry.ItemInstance->CaptureWeaponState(State);
+	}
+	else if (bInlineWeaponState && Entry.ItemDef && Entry.ItemDef->IsWeapon())
+	{
+		State = Entry.WeaponState;
+	}
+	else
+	{
+		bHasWeaponState = false;
+	}
+
+	if (bHasWeaponState)
+	{
+		SaveEntry.CurrentAmmo = State.CurrentAmmo;
+		SaveEntry.Quality = State.Quality;
 
-			// Restore mods
-			if (SaveEntry.SavedModTier1.IsValid())
-			{
-				Inst->InstalledModTier1 = Cast<UOutlawWeaponModDefinition>(SaveEntry.SavedModTier1.TryLoad());
-			}
-			if (SaveEntry.SavedModTier2.IsValid())
-			{
-				Inst->InstalledModTier2 = Cast<UOutlawWeaponModDefinition>(SaveEntry.SavedModTier2.TryLoad());
-			}
+		// Save affixes
+		for (const FOutlawItemAffix& Affix : State.Affixes)
+		{
+			FOutlawSavedAffix SavedAffix;
+			SavedAffix.AffixDefPath = FSoftObjectPath(Affix.AffixDef);
+			SavedAffix.RolledValue = Affix.RolledValue;
+			SavedAffix.Slot = static_cast<uint8>(Affix.Slot);
+			SaveEntry.SavedAffixes.Add(SavedAffix);
 		}
 
-		if (SaveEntry.EquippedSlotTag.IsValid())
+		// Save socketed gems
+		for (const FOutlawSocketSlot& Socket : State.SocketSlots)
 		{
-			ItemsToEquip.Add(TPair<int32, FGameplayTag>(NewInstanceId, SaveEntry.EquippedSlotTag));
+			SaveEntry.SavedSocketedGems.Add(Socket.SocketedGem ? FSoftObjectPath(Socket.SocketedGem) : FSoftObjectPath());
 		}
-	}
 
-	// Re-equip items that were equipped at save time
-	for (const auto& Pair : ItemsToEquip)
-	{
-		EquipItem(Pair.Key);
+		// Save mods
+		if (State.InstalledModTier1)
+		{
+			SaveEntry.SavedModTier1 = FSoftObjectPath(State.InstalledModTier1);
+		}
+		if (State.InstalledModTier2)
+		{
+			SaveEntry.SavedModTier2 = FSoftObjectPath(State.InstalledModTier2);
+		}
+
+		SaveEntry.AffixSeed = State.AffixSeed;
+		SaveEntry.AffixItemLevel = State.AffixItemLevel;
 	}
 
-	BroadcastInventoryChanged();
+	return SaveEntry;
 }
 
-// ── Item Instance API ────────────────────────────────────────────
-
-UOutlawItemInstance* UOutlawInventoryComponent::GetItemInstance(FGameplayTag SlotTag) const
+void UOutlawInventoryComponent::MarkSaveDirty(int32 InstanceId)
 {
-	const FOutlawEquipmentSlotInfo* Slot = FindEquipmentSlot(SlotTag);
-	if (!Slot || Slot->EquippedItemInstanceId == INDEX_NONE)
+	if (InstanceId != INDEX_NONE && GetOwner() && GetOwner()->HasAuthority())
 	{
-		return nullptr;
+		SaveDirtyIds.Add(InstanceId);
 	}
-
-	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Slot->EquippedItemInstanceId);
-	return Entry ? Entry->ItemInstance : nullptr;
-}
-
-UOutlawItemInstance* UOutlawInventoryComponent::GetItemInstanceById(int32 InstanceId) const
-{
-	const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(InstanceId);
-	return Entry ? Entry->ItemInstance : nullptr;
 }
 
-// ── Private Helpers ─────────────────────────────────────────────
+// ── Batching ────────────────────────────────────────────────────
 
-UOutlawItemInstance* UOutlawInventoryComponent::CreateItemInstance(UOutlawItemDefinition* ItemDef, int32 InstanceId)
+void UOutlawInventoryComponent::BeginBatch()
 {
-	if (!ItemDef || !ItemDef->IsWeapon())
+	if (BatchDepth++ == 0)
 	{
-		return nullptr;
+		BatchFirstNewId = NextInstanceId;
 	}
 
-	UOutlawItemInstance* Instance = NewObject<UOutlawItemInstance>(GetOwner());
-	Instance->ItemDef = ItemDef;
-	Instance->InstanceId = InstanceId;
+	InventoryList.BeginDeferredArrayDirty();
+}
 
-	// Initialize shooter state
-	if (ItemDef->ShooterWeaponData)
-	{
-		Instance->CurrentAmmo = ItemDef->ShooterWeaponData->MagazineSize;
-	}
+void UOutlawInventoryComponent::EndBatch()
+{
+	check(BatchDepth > 0);
 
-	// Initialize ARPG state — copy default socket layout
-	if (ItemDef->ARPGWeaponData)
+	InventoryList.EndDeferredArrayDirty();
+	if (--BatchDepth > 0)
 	{
-		Instance->SocketSlots = ItemDef->ARPGWeaponData->DefaultSocketLayout;
+		return;
 	}
 
-	return Instance;
-}
+	const TArray<int32> AffectedIds = MoveTemp(BatchAffectedIds);
+	BatchAffectedIds.Reset();
+	BatchOriginalStackCounts.Reset();
+	BatchFirstNewId = INDEX_NONE;
 
-UOutlawWeaponManagerComponent* UOutlawInventoryComponent::GetWeaponManager() const
-{
-	AActor* Owner = GetOwner();
-	return Owner ? Owner->FindComponentByClass<UOutlawWeaponManagerComponent>() : nullptr;
+	if (bBatchBroadcastPending)
+	{
+		bBatchBroadcastPending = false;
+		BroadcastInventoryChanged();
+		OnInventoryBatchChanged.Broadcast(AffectedIds);
+	}
 }
 
-UAbilitySystemComponent* UOutlawInventoryComponent::GetASC() const
+void UOutlawInventoryComponent::NoteBatchChange(const FOutlawInventoryEntry& Entry)
 {
-	AActor* Owner = GetOwner();
-	if (!Owner)
+	if (BatchDepth == 0)
 	{
-		return nullptr;
+		return;
 	}
 
-	// Try the owner actor first (works for characters that implement IAbilitySystemInterface)
-	if (const IAbilitySystemInterface* ASI = Cast<IAbilitySystemInterface>(Owner))
+	BatchAffectedIds.AddUnique(Entry.InstanceId);
+	if (Entry.InstanceId < BatchFirstNewId && !BatchOriginalStackCounts.Contains(Entry.InstanceId))
 	{
-		return ASI->GetAbilitySystemComponent();
+		BatchOriginalStackCounts.Add(Entry.InstanceId, Entry.AccountedStackCount);
 	}
+}
 
-	// Try the pawn's player state (common in multiplayer setups like this project)
-	if (const APawn* Pawn = Cast<APawn>(Owner))
+void UOutlawInventoryComponent::RollbackBatchAdds()
+{
+	// Copies: the removals and stack changes below note themselves into the batch again
+	const TArray<int32> AffectedIds = BatchAffectedIds;
+	const TMap<int32, int32> OriginalStackCounts = BatchOriginalStackCounts;
+
+	for (const int32 Id : AffectedIds)
 	{
-		if (const APlayerState* PS = Pawn->GetPlayerState())
+		if (Id < BatchFirstNewId)
 		{
-			if (const IAbilitySystemInterface* ASI = Cast<IAbilitySystemInterface>(PS))
-			{
-				return ASI->GetAbilitySystemComponent();
-			}
+			continue;
 		}
-	}
 
-	return nullptr;
-}
-
-FOutlawEquipmentSlotInfo* UOutlawInventoryComponent::FindEquipmentSlot(FGameplayTag SlotTag)
-{
-	for (FOutlawEquipmentSlotInfo& Slot : EquipmentSlots)
-	{
-		if (Slot.SlotTag == SlotTag)
+		const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Id);
+		if (!Entry)
 		{
-			return &Slot;
+			continue;
 		}
-	}
-	return nullptr;
-}
 
-const FOutlawEquipmentSlotInfo* UOutlawInventoryComponent::FindEquipmentSlot(FGameplayTag SlotTag) const
-{
-	for (const FOutlawEquipmentSlotInfo& Slot : EquipmentSlots)
-	{
-		if (Slot.SlotTag == SlotTag)
+		if (IsGridMode() && Entry->ItemDef && Entry->GridX != INDEX_NONE)
 		{
-			return &Slot;
+			ClearOccupancy(Entry->GridX, Entry->GridY, Entry->ItemDef->GridWidth, Entry->ItemDef->GridHeight);
 		}
+		InventoryList.RemoveEntry(Id);
 	}
-	return nullptr;
-}
 
-void UOutlawInventoryComponent::BroadcastInventoryChanged()
-{
-	// On clients, rebuild the occupancy grid from replicated entries
-	if (IsGridMode() && GetOwner() && !GetOwner()->HasAuthority())
+	for (const TPair<int32, int32>& Pair : OriginalStackCounts)
 	{
-		RebuildOccupancyGrid();
+		if (FOutlawInventoryEntry* Entry = InventoryList.FindEntry(Pair.Key))
+		{
+			SetEntryStackCount(*Entry, Pair.Value);
+		}
 	}
 
-	OnInventoryChanged.Broadcast();
-}
-
-int32 UOutlawInventoryComponent::GenerateInstanceId()
-{
-	return NextInstanceId++;
+	// Net result is no change: nothing to announce
+	BatchAffectedIds.Reset();
+	BatchOriginalStackCounts.Reset();
+	bBatchBroadcastPending = false;
 }
 
 // ── Grid Mode ───────────────────────────────────────────────────
@@ -1004,18 +3149,22 @@ int32 UOutlawInventoryComponent::AddItemAtPosition(UOutlawItemDefinition* ItemDe
 		return 0;
 	}
 
-	if (!GetOwner()->HasAuthority())
+	if (!GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("AddItemAtPosition")))
 	{
 		return 0;
 	}
 
 	// Try stacking at this position first
-	if (ItemDef->MaxStackSize > 1)
+	const FOutlawItemDefStacks* Stacks = StacksByDef.Find(ItemDef);
+	if (ItemDef->MaxStackSize > 1 && Stacks)
 	{
-		for (FOutlawInventoryEntry& Entry : InventoryList.Entries)
+		for (const int32 OpenId : Stacks->OpenStackIds)
 		{
-			if (Entry.ItemDef == ItemDef && Entry.GridX == X && Entry.GridY == Y && Entry.StackCount < ItemDef->MaxStackSize)
+			FOutlawInventoryEntry* Found = InventoryList.FindEntry(OpenId);
+			if (Found && Found->GridX == X && Found->GridY == Y)
 			{
+				// Returns right after mutating, so OpenStackIds changing under the loop is fine
+				FOutlawInventoryEntry& Entry = *Found;
 				const int32 SpaceInStack = ItemDef->MaxStackSize - Entry.StackCount;
 				const int32 ToAdd = FMath::Min(Count, SpaceInStack);
 
@@ -1023,14 +3172,12 @@ int32 UOutlawInventoryComponent::AddItemAtPosition(UOutlawItemDefinition* ItemDe
 				{
 					const int32 CanFit = FMath::FloorToInt32((MaxWeight - GetCurrentWeight()) / ItemDef->Weight);
 					if (CanFit <= 0) return 0;
-					Entry.StackCount += FMath::Min(ToAdd, CanFit);
-					InventoryList.MarkItemDirty(Entry);
+					SetEntryStackCount(Entry, Entry.StackCount + FMath::Min(ToAdd, CanFit));
 					BroadcastInventoryChanged();
 					return FMath::Min(ToAdd, CanFit);
 				}
 
-				Entry.StackCount += ToAdd;
-				InventoryList.MarkItemDirty(Entry);
+				SetEntryStackCount(Entry, Entry.StackCount + ToAdd);
 				BroadcastInventoryChanged();
 				return ToAdd;
 			}
@@ -1067,7 +3214,17 @@ int32 UOutlawInventoryComponent::AddItemAtPosition(UOutlawItemDefinition* ItemDe
 
 bool UOutlawInventoryComponent::MoveItem(int32 InstanceId, int32 NewX, int32 NewY)
 {
-	if (!IsGridMode() || !GetOwner()->HasAuthority())
+	if (!IsGridMode())
+	{
+		return false;
+	}
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return PredictMoveItem(InstanceId, NewX, NewY);
+	}
+
+	if (RejectWhileLoading(TEXT("MoveItem")))
 	{
 		return false;
 	}
@@ -1094,6 +3251,7 @@ bool UOutlawInventoryComponent::MoveItem(int32 InstanceId, int32 NewX, int32 New
 	Entry->GridX = NewX;
 	Entry->GridY = NewY;
 	SetOccupancy(NewX, NewY, Entry->ItemDef->GridWidth, Entry->ItemDef->GridHeight, InstanceId);
+	NoteEntryChange(InstanceId, OutlawInventoryChange::Moved);
 
 	InventoryList.MarkItemDirty(*Entry);
 	BroadcastInventoryChanged();
@@ -1108,16 +3266,229 @@ bool UOutlawInventoryComponent::FindFreeSpace(const UOutlawItemDefinition* ItemD
 	}
 
 	// Scan top-to-bottom, left-to-right
-	for (int32 Y = 0; Y <= InventoryGridHeight - ItemDef->GridHeight; ++Y)
+	return OccupancyMask.FindFreeRect(ItemDef->GridWidth, ItemDef->GridHeight, OutX, OutY);
+}
+
+bool UOutlawInventoryComponent::AutoArrangeGrid(float TimeBudgetMs)
+{
+	using namespace OutlawGridPacking;
+
+	if (!IsGridMode() || !GetOwner()->HasAuthority() || RejectWhileLoading(TEXT("AutoArrangeGrid")))
+	{
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double Deadline = StartTime + FMath::Max(0.0f, TimeBudgetMs) / 1000.0;
+
+	// Every placed entry is a piece; entries without a grid position stay as they are
+	TArray<int32> PieceIds;
+	TArray<FPiece> Pieces;
+	TArray<FIntPoint> CurrentPositions;
+	const FOutlawInventoryHotFields& Hot = InventoryList.GetHotFields();
+	for (int32 i = 0; i < InventoryList.Entries.Num(); ++i)
+	{
+		const FOutlawInventoryEntry& Entry = InventoryList.Entries[i];
+		if (Hot.HasDef(i) && Entry.GridX != INDEX_NONE)
+		{
+			PieceIds.Add(Entry.InstanceId);
+			Pieces.Add({ Hot.GridWidth[i], Hot.GridHeight[i] });
+			CurrentPositions.Add(FIntPoint(Entry.GridX, Entry.GridY));
+		}
+	}
+
+	if (Pieces.IsEmpty())
+	{
+		return false;
+	}
+
+	// The current layout is the one to beat
+	FLayoutScore BestScore = Score(Pieces, CurrentPositions, InventoryGridWidth);
+	TArray<FIntPoint> BestPositions;
+
+	TArray<TArray<int32>> Orders;
+	SeedOrders(Pieces, Orders);
+	TArray<int32> SearchOrder = Orders[0];
+
+	FOutlawInventoryGridMask Board;
+	TArray<FIntPoint> Positions;
+	auto TryOrder = [&](const TArray<int32>& Order)
+	{
+		Board.Init(InventoryGridWidth, InventoryGridHeight);
+		if (!Pack(Board, Pieces, Order, Positions))
+		{
+			return;
+		}
+
+		const FLayoutScore Candidate = Score(Pieces, Positions, InventoryGridWidth);
+		if (Candidate < BestScore)
+		{
+			BestScore = Candidate;
+			BestPositions = Positions;
+			SearchOrder = Order;
+		}
+	};
+
+	bool bOutOfBudget = false;
+	for (int32 OrderIdx = 0; OrderIdx < Orders.Num(); ++OrderIdx)
+	{
+		if (OrderIdx > 0 && FPlatformTime::Seconds() > Deadline)
+		{
+			bOutOfBudget = true;
+			break;
+		}
+		TryOrder(Orders[OrderIdx]);
+	}
+
+	// Spend what is left swapping pairs in the best order so far. Seeded from the piece count so the
+	// same inventory always arranges the same way.
+	if (!bOutOfBudget && SearchOrder.Num() > 1)
+	{
+		FRandomStream Stream(Pieces.Num());
+		for (int32 Iteration = 0; Iteration < MaxRefineIterations && FPlatformTime::Seconds() <= Deadline; ++Iteration)
+		{
+			TArray<int32> Order = SearchOrder;
+			Order.Swap(Stream.RandRange(0, Order.Num() - 1), Stream.RandRange(0, Order.Num() - 1));
+			TryOrder(Order);
+		}
+	}
+
+	if (BestPositions.IsEmpty())
+	{
+		return false;
+	}
+
+	// Commit as one batch: a single array-dirty mark, one broadcast
+	BeginBatch();
+
+	for (int32 PieceIdx = 0; PieceIdx < PieceIds.Num(); ++PieceIdx)
+	{
+		FOutlawInventoryEntry* Entry = InventoryList.FindEntry(PieceIds[PieceIdx]);
+		const FIntPoint& Position = BestPositions[PieceIdx];
+		if (!Entry || (Entry->GridX == Position.X && Entry->GridY == Position.Y))
+		{
+			continue;
+		}
+
+		Entry->GridX = Position.X;
+		Entry->GridY = Position.Y;
+		InventoryList.MarkItemDirty(*Entry);
+		NoteEntryChange(Entry->InstanceId, OutlawInventoryChange::Moved);
+		BatchAffectedIds.AddUnique(Entry->InstanceId);
+	}
+
+	RebuildOccupancyGrid();
+	BroadcastInventoryChanged();
+	EndBatch();
+
+	UE_LOG(LogOutlawInventory, Verbose, TEXT("AutoArrangeGrid: %d items, %d rows used, %.2f ms%s"),
+		Pieces.Num(), BestScore.UsedRows, (FPlatformTime::Seconds() - StartTime) * 1000.0, bOutOfBudget ? TEXT(" (budget exhausted)") : TEXT(""));
+	return true;
+}
+
+bool UOutlawInventoryComponent::CanFitItems(const TArray<FOutlawItemAddRequest>& Requests, bool bAllowRearrange) const
+{
+	using namespace OutlawGridPacking;
+
+	// Room left in partial stacks per definition; consumed by requests in order, and grown by the new stacks they open
+	TMap<const UOutlawItemDefinition*, int32> StackRoom;
+	double Weight = CachedWeight;
+	TArray<FPiece> NewPieces;
+
+	for (const FOutlawItemAddRequest& Request : Requests)
 	{
-		for (int32 X = 0; X <= InventoryGridWidth - ItemDef->GridWidth; ++X)
+		const UOutlawItemDefinition* ItemDef = Request.ItemDef;
+		if (!ItemDef || Request.Count <= 0)
+		{
+			continue;
+		}
+
+		Weight += static_cast<double>(ItemDef->Weight) * Request.Count;
+
+		int32* Room = StackRoom.Find(ItemDef);
+		if (!Room)
 		{
-			if (IsRectFree(X, Y, ItemDef->GridWidth, ItemDef->GridHeight))
+			int32 OpenRoom = 0;
+			if (const FOutlawItemDefStacks* Stacks = StacksByDef.Find(ItemDef))
 			{
-				OutX = X;
-				OutY = Y;
-				return true;
+				for (const int32 OpenId : Stacks->OpenStackIds)
+				{
+					if (const FOutlawInventoryEntry* Entry = InventoryList.FindEntry(OpenId))
+					{
+						OpenRoom += ItemDef->MaxStackSize - Entry->StackCount;
+					}
+				}
 			}
+			Room = &StackRoom.Add(ItemDef, ItemDef->MaxStackSize > 1 ? OpenRoom : 0);
+		}
+
+		const int32 ToppedUp = FMath::Min(*Room, Request.Count);
+		const int32 Remaining = Request.Count - ToppedUp;
+		*Room -= ToppedUp;
+
+		const int32 StackSize = FMath::Max(1, ItemDef->MaxStackSize);
+		const int32 NewStacks = FMath::DivideAndRoundUp(Remaining, StackSize);
+		*Room += NewStacks * StackSize - Remaining;
+
+		for (int32 StackIdx = 0; StackIdx < NewStacks; ++StackIdx)
+		{
+			NewPieces.Add({ ItemDef->GridWidth, ItemDef->GridHeight });
+		}
+	}
+
+	if (Weight > MaxWeight)
+	{
+		return false;
+	}
+
+	if (!IsGridMode())
+	{
+		return NewPieces.Num() <= GetRemainingSlots();
+	}
+
+	if (NewPieces.IsEmpty())
+	{
+		return true;
+	}
+
+	// Where AddItems would put them: request order, first fit into today's free space
+	TArray<int32> RequestOrder;
+	for (int32 PieceIdx = 0; PieceIdx < NewPieces.Num(); ++PieceIdx)
+	{
+		RequestOrder.Add(PieceIdx);
+	}
+
+	FOutlawInventoryGridMask Board = OccupancyMask;
+	TArray<FIntPoint> Positions;
+	if (Pack(Board, NewPieces, RequestOrder, Positions))
+	{
+		return true;
+	}
+
+	if (!bAllowRearrange)
+	{
+		return false;
+	}
+
+	// Otherwise repack everything, existing items included, the way AutoArrangeGrid seeds its search
+	TArray<FPiece> AllPieces = NewPieces;
+	const FOutlawInventoryHotFields& Hot = InventoryList.GetHotFields();
+	for (int32 i = 0; i < InventoryList.Entries.Num(); ++i)
+	{
+		if (Hot.HasDef(i) && InventoryList.Entries[i].GridX != INDEX_NONE)
+		{
+			AllPieces.Add({ Hot.GridWidth[i], Hot.GridHeight[i] });
+		}
+	}
+
+	TArray<TArray<int32>> Orders;
+	SeedOrders(AllPieces, Orders);
+	for (const TArray<int32>& Order : Orders)
+	{
+		Board.Init(InventoryGridWidth, InventoryGridHeight);
+		if (Pack(Board, AllPieces, Order, Positions))
+		{
+			return true;
 		}
 	}
 
@@ -1150,26 +3521,51 @@ void UOutlawInventoryComponent::RebuildOccupancyGrid()
 		return;
 	}
 
-	OccupancyGrid.Init(INDEX_NONE, InventoryGridWidth * InventoryGridHeight);
+	ResetOccupancyGrid();
 
-	for (const FOutlawInventoryEntry& Entry : InventoryList.Entries)
+	const FOutlawInventoryHotFields& Hot = InventoryList.GetHotFields();
+	for (int32 i = 0; i < InventoryList.Entries.Num(); ++i)
 	{
-		if (Entry.ItemDef && Entry.GridX != INDEX_NONE)
+		FOutlawInventoryEntry& Entry = InventoryList.Entries[i];
+		Entry.StampedGridX = INDEX_NONE;
+		Entry.StampedGridY = INDEX_NONE;
+		Entry.StampedGridW = 0;
+		Entry.StampedGridH = 0;
+
+		if (Hot.HasDef(i) && Entry.GridX != INDEX_NONE)
 		{
-			SetOccupancy(Entry.GridX, Entry.GridY, Entry.ItemDef->GridWidth, Entry.ItemDef->GridHeight, Entry.InstanceId);
+			SetOccupancy(Entry.GridX, Entry.GridY, Hot.GridWidth[i], Hot.GridHeight[i], Entry.InstanceId);
+			Entry.StampedGridX = Entry.GridX;
+			Entry.StampedGridY = Entry.GridY;
+			Entry.StampedGridW = Hot.GridWidth[i];
+			Entry.StampedGridH = Hot.GridHeight[i];
 		}
 	}
 }
 
+void UOutlawInventoryComponent::ResetOccupancyGrid()
+{
+	OccupancyGrid.Init(INDEX_NONE, InventoryGridWidth * InventoryGridHeight);
+	OccupancyMask.Init(InventoryGridWidth, InventoryGridHeight);
+	FreeGridCellCount = OccupancyGrid.Num();
+}
+
 void UOutlawInventoryComponent::SetOccupancy(int32 GridX, int32 GridY, int32 W, int32 H, int32 InstanceId)
 {
 	for (int32 Y = GridY; Y < GridY + H && Y < InventoryGridHeight; ++Y)
 	{
 		for (int32 X = GridX; X < GridX + W && X < InventoryGridWidth; ++X)
 		{
-			OccupancyGrid[GridIndex(X, Y)] = InstanceId;
+			int32& Cell = OccupancyGrid[GridIndex(X, Y)];
+			if (Cell == INDEX_NONE)
+			{
+				--FreeGridCellCount;
+			}
+			Cell = InstanceId;
 		}
 	}
+
+	OccupancyMask.SetRect(GridX, GridY, W, H);
 }
 
 void UOutlawInventoryComponent::ClearOccupancy(int32 GridX, int32 GridY, int32 W, int32 H)
@@ -1178,31 +3574,54 @@ void UOutlawInventoryComponent::ClearOccupancy(int32 GridX, int32 GridY, int32 W
 	{
 		for (int32 X = GridX; X < GridX + W && X < InventoryGridWidth; ++X)
 		{
-			OccupancyGrid[GridIndex(X, Y)] = INDEX_NONE;
+			int32& Cell = OccupancyGrid[GridIndex(X, Y)];
+			if (Cell != INDEX_NONE)
+			{
+				++FreeGridCellCount;
+			}
+			Cell = INDEX_NONE;
 		}
 	}
+
+	OccupancyMask.ClearRect(GridX, GridY, W, H);
 }
 
-bool UOutlawInventoryComponent::IsRectFree(int32 X, int32 Y, int32 W, int32 H, int32 IgnoreInstanceId) const
+void UOutlawInventoryComponent::ClearOccupancyOf(int32 GridX, int32 GridY, int32 W, int32 H, int32 InstanceId)
 {
-	if (X < 0 || Y < 0 || X + W > InventoryGridWidth || Y + H > InventoryGridHeight)
+	for (int32 Y = GridY; Y < GridY + H && Y < InventoryGridHeight; ++Y)
 	{
-		return false;
+		for (int32 X = GridX; X < GridX + W && X < InventoryGridWidth; ++X)
+		{
+			int32& Cell = OccupancyGrid[GridIndex(X, Y)];
+			if (Cell == InstanceId)
+			{
+				Cell = INDEX_NONE;
+				++FreeGridCellCount;
+				OccupancyMask.ClearRect(X, Y, 1, 1);
+			}
+		}
 	}
+}
+
+bool UOutlawInventoryComponent::IsOccupancyGridSized() const
+{
+	return OccupancyGrid.Num() == InventoryGridWidth * InventoryGridHeight;
+}
 
-	for (int32 CY = Y; CY < Y + H; ++CY)
+bool UOutlawInventoryComponent::IsRectFree(int32 X, int32 Y, int32 W, int32 H, int32 IgnoreInstanceId) const
+{
+	if (IgnoreInstanceId != INDEX_NONE)
 	{
-		for (int32 CX = X; CX < X + W; ++CX)
+		const FOutlawInventoryEntry* Ignored = InventoryList.FindEntry(IgnoreInstanceId);
+		if (Ignored && Ignored->ItemDef && Ignored->GridX != INDEX_NONE)
 		{
-			const int32 Cell = OccupancyGrid[GridIndex(CX, CY)];
-			if (Cell != INDEX_NONE && Cell != IgnoreInstanceId)
-			{
-				return false;
-			}
+			const FIntRect IgnoreRect(Ignored->GridX, Ignored->GridY,
+				Ignored->GridX + Ignored->ItemDef->GridWidth, Ignored->GridY + Ignored->ItemDef->GridHeight);
+			return OccupancyMask.IsRectFreeIgnoring(X, Y, W, H, IgnoreRect);
 		}
 	}
 
-	return true;
+	return OccupancyMask.IsRectFree(X, Y, W, H);
 }
 
 int32 UOutlawInventoryComponent::GridIndex(int32 X, int32 Y) const
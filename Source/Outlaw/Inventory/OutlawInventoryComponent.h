@@ -7,11 +7,13 @@
 #include "GameplayTagContainer.h"
 #include "OutlawInventoryTypes.h"
 #include "OutlawItemDefinition.h"
+#include "OutlawInventoryGridMask.h"
 #include "OutlawInventoryComponent.generated.h"
 
 class UAbilitySystemComponent;
 class UOutlawItemInstance;
 class UOutlawWeaponManagerComponent;
+struct FStreamableHandle;
 
 /** Criteria for sorting inventory entries. */
 UENUM(BlueprintType)
@@ -24,6 +26,10 @@ enum class EOutlawInventorySortMode : uint8
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryChanged);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryLoaded);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryBatchChanged, const TArray<int32>&, AffectedInstanceIds);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInventoryChangeSet, const FOutlawInventoryChangeSet&, ChangeSet);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnInventoryChangeSetNative, const FOutlawInventoryChangeSet&);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnItemEquipped, const UOutlawItemDefinition*, ItemDef, FGameplayTag, SlotTag);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnItemUnequipped, const UOutlawItemDefinition*, ItemDef, FGameplayTag, SlotTag);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemUsed, const UOutlawItemDefinition*, ItemDef);
@@ -73,6 +79,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	int32 RemoveItemByDef(UOutlawItemDefinition* ItemDef, int32 Count);
 
+	/**
+	 * Move an entry (or part of its stack) into another inventory as one operation. Like AddItem, the target's open
+	 * stacks of the same item are topped up first and only the remainder takes a new slot or grid space. Slot, grid
+	 * space and weight on the target are validated before either side changes. A whole weapon entry keeps its UOutlawItemInstance; it is
+	 * re-parented to the target, not re-created. Both owners are flagged for the next net update together. Server only.
+	 * @param Target      Receiving inventory. Must differ from this one.
+	 * @param InstanceId  Entry to move. Equipped entries are refused.
+	 * @param Count       Items to move; 0 or >= the stack moves the whole entry.
+	 * @param TargetX     Grid cell in the target (grid mode); places the whole amount there as a new stack. INDEX_NONE
+	 *                    merges into open stacks and puts any remainder in the first free space.
+	 * @param TargetY     Grid cell in the target (grid mode).
+	 * @return True if the items were moved; on false neither inventory was touched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool TransferItemTo(UOutlawInventoryComponent* Target, int32 InstanceId, int32 Count = 0, int32 TargetX = -1, int32 TargetY = -1);
+
 	/** Find all inventory entries that have items matching a gameplay tag. */
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	TArray<FOutlawInventoryEntry> FindItemsByTag(FGameplayTag Tag) const;
@@ -105,6 +127,56 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	TArray<FOutlawInventoryEntry> FindItemsByRarity(EOutlawItemRarity Rarity) const;
 
+	// ── Native Query API ────────────────────────────────────────
+	// Served from incrementally maintained indexes: cost is proportional to the result, nothing is copied.
+	// Views list instance IDs in no particular order and are invalidated by the next inventory change.
+
+	/** Look up an entry by instance ID. O(1). Pointer is invalidated by the next inventory change. */
+	const FOutlawInventoryEntry* FindEntry(int32 InstanceId) const;
+
+	/** Instance IDs of entries whose item definition has the given type. */
+	TConstArrayView<int32> GetInstanceIdsByType(EOutlawItemType ItemType) const;
+
+	/** Instance IDs of entries whose item definition has the given rarity. */
+	TConstArrayView<int32> GetInstanceIdsByRarity(EOutlawItemRarity Rarity) const;
+
+	/** Instance IDs of equippable entries whose slot tag matches exactly. */
+	TConstArrayView<int32> GetInstanceIdsForSlot(FGameplayTag SlotTag) const;
+
+	/** Instance IDs of entries whose ItemTags contain Tag or a child of it (same rule as HasTag). */
+	TConstArrayView<int32> GetInstanceIdsByTag(FGameplayTag Tag) const;
+
+	// ── Batch API ───────────────────────────────────────────────
+
+	/**
+	 * Add several items as one operation (e.g. a chest or boss drop). Fires OnInventoryChanged and
+	 * OnInventoryBatchChanged once at the end instead of once per item.
+	 * @param Requests    Items and counts to add, applied in order.
+	 * @param Mode        AllOrNothing rolls every change back if any request cannot be added in full.
+	 * @param OutResults  One result per request, same order, including the instance IDs each request created.
+	 * @return True if every request was added in full.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Batch")
+	bool AddItems(const TArray<FOutlawItemAddRequest>& Requests, EOutlawInventoryBatchMode Mode, TArray<FOutlawItemBatchResult>& OutResults);
+
+	/**
+	 * Remove several items as one operation. AllOrNothing validates every request up front and changes nothing on failure.
+	 * Requests that target an InstanceId are applied before definition-wide ones so the latter cannot drain a targeted stack.
+	 * @param Requests    Entries or item types and counts to remove.
+	 * @param Mode        AllOrNothing or BestEffort.
+	 * @param OutResults  One result per request, same order.
+	 * @return True if every request was removed in full.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Batch")
+	bool RemoveItems(const TArray<FOutlawItemRemoveRequest>& Requests, EOutlawInventoryBatchMode Mode, TArray<FOutlawItemBatchResult>& OutResults);
+
+	/**
+	 * Report that an entry's item state changed outside the inventory (e.g. ammo, affixes, sockets on its item instance),
+	 * so it appears in the next change set as Changed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void NotifyItemChanged(int32 InstanceId);
+
 	// ── Sorting API ─────────────────────────────────────────────
 
 	/**
@@ -115,20 +187,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Sort")
 	void SortInventory(EOutlawInventorySortMode SortMode, bool bDescending = false);
 
+	/** Instance IDs of all entries in display (SortOrder) order. Valid on server and clients. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Sort")
+	TArray<int32> GetInstanceIdsInSortOrder() const;
+
 	// ── Equipment API ───────────────────────────────────────────
 
 	/**
 	 * Equip an item from the inventory into its designated equipment slot.
 	 * Grants the item's ability set to the ASC.
+	 * On the owning client this is predicted: the slot shows the item at once and the server confirms or rolls back.
 	 * @param InstanceId  The instance ID of the inventory entry to equip.
-	 * @return True if the item was successfully equipped.
+	 * @return True if the item was successfully equipped (or, on a client, the prediction was made).
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Equipment")
 	bool EquipItem(int32 InstanceId);
 
 	/**
 	 * Unequip the item from the given equipment slot.
-	 * Revokes the item's ability set from the ASC.
+	 * Revokes the item's ability set from the ASC. Predicted on the owning client, like EquipItem.
 	 * @param SlotTag  The equipment slot to unequip.
 	 * @return True if the slot was occupied and the item was unequipped.
 	 */
@@ -143,6 +220,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Equipment")
 	bool IsSlotOccupied(FGameplayTag SlotTag) const;
 
+	/** Slot the given instance is equipped in, or an empty tag if it is not equipped. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Equipment")
+	FGameplayTag GetEquippedSlotOf(int32 InstanceId) const;
+
+	/** Check if the given instance is equipped in any slot. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Equipment")
+	bool IsItemEquipped(int32 InstanceId) const;
+
 	// ── Use API ─────────────────────────────────────────────────
 
 	/**
@@ -166,20 +251,93 @@ public:
 	/**
 	 * Get the item instance by instance ID.
 	 * @param InstanceId  The unique instance ID.
-	 * @return The item instance, or nullptr if not found or not a weapon.
+	 * @return The item instance, or nullptr if not found or not a weapon (or, with bInlineWeaponState, not equipped).
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Weapon")
 	UOutlawItemInstance* GetItemInstanceById(int32 InstanceId) const;
 
+	/**
+	 * Current weapon state of an entry, whether it lives in a materialized instance or inline in the entry.
+	 * @return False if the entry does not exist or is not a weapon.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Weapon")
+	bool GetWeaponStateById(int32 InstanceId, FOutlawItemWeaponState& OutState) const;
+
+	/**
+	 * Roll an entry's affixes (see UOutlawItemInstance::RollAffixes) wherever its weapon state lives: the item
+	 * instance if it has one, otherwise the inline state. Reports the entry as Changed. Server only.
+	 * @param Seed  Generation seed, normally from UOutlawItemInstance::MakeAffixSeed. 0 draws a fresh one.
+	 * @return False if the entry does not exist or its item has no affix pool.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Weapon")
+	bool RollItemAffixes(int32 InstanceId, int32 ItemLevel, int64 Seed = 0);
+
 	// ── Save/Load ───────────────────────────────────────────────
 
-	/** Serialize the full inventory state for saving. */
+	/**
+	 * Serialize the full inventory state for saving. Entries untouched since the last save reuse their cached
+	 * record; only dirty ones are rebuilt. Does not move the delta baseline; see CommitSaveBaseline.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	FOutlawInventorySaveData SaveInventory();
+
+	/**
+	 * Only what changed since the last CommitSaveBaseline, for appending to the save written at that point.
+	 * Fold deltas back into a full save with FOutlawInventorySaveData::ApplyDelta. Calling it again before
+	 * committing returns the same changes plus any newer ones.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
-	FOutlawInventorySaveData SaveInventory() const;
+	FOutlawInventorySaveDelta SaveInventoryDelta();
 
-	/** Load inventory from previously saved data. Clears current inventory first. */
+	/** SaveInventory encoded in the compact binary form (deduplicated asset path table, packed ints). */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
-	void LoadInventory(const FOutlawInventorySaveData& Data);
+	TArray<uint8> SaveInventoryBinary();
+
+	/**
+	 * Mark the current state as persisted: the next SaveInventoryDelta is relative to it. Call once the save or
+	 * delta just taken has actually been written. Loading an inventory commits its loaded state.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	void CommitSaveBaseline();
+
+	/**
+	 * Decode a blob from SaveInventoryBinary and LoadInventory it.
+	 * @return False if the blob is malformed or from a newer format version; the inventory is left untouched.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool LoadInventoryBinary(const TArray<uint8>& Bytes, bool bForceSynchronous = false);
+
+	/**
+	 * Load inventory from previously saved data. Clears current inventory first.
+	 * Every referenced asset is requested as one async batch; the current inventory is replaced when it completes
+	 * and OnInventoryLoaded fires. Loads synchronously outside game worlds (editor, automation) or when forced.
+	 * A second call while a load is pending supersedes the first. While a load is pending every mutation (adds,
+	 * removes, transfers, equips, moves, predicted ops) is refused, since the completed load would discard it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	void LoadInventory(const FOutlawInventorySaveData& Data, bool bForceSynchronous = false);
+
+	/** True while LoadInventory is waiting on assets. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	bool IsLoadPending() const;
+
+	/** Phase timings of the most recent completed LoadInventory. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Save")
+	FOutlawInventoryLoadStats GetLastLoadStats() const { return LastLoadStats; }
+
+	/**
+	 * Save record of a single entry, as SaveInventory would write it. Used to move items into external storage (stash).
+	 * @return False if no entry has this InstanceId.
+	 */
+	bool ExportItemRecord(int32 InstanceId, FOutlawInventoryItemSaveEntry& OutRecord) const;
+
+	/**
+	 * Add the item described by a save record, restoring its weapon state. Grid position, equipped slot and
+	 * InstanceId in the record are ignored; the item is placed like AddItem would place it.
+	 * Loads any referenced asset that is not already in memory synchronously. Server only.
+	 * @return Number of items actually added.
+	 */
+	int32 AddItemFromRecord(const FOutlawInventoryItemSaveEntry& Record);
 
 	// ── Delegates ───────────────────────────────────────────────
 
@@ -187,6 +345,20 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Inventory")
 	FOnInventoryChanged OnInventoryChanged;
 
+	/**
+	 * Fires at most once per frame with the entries added, removed, changed, or moved since the last flush.
+	 * Works on server and clients. Prefer this over OnInventoryChanged for widgets that can patch individual tiles.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory")
+	FOnInventoryChangeSet OnInventoryChangeSet;
+
+	/** Native counterpart of OnInventoryChangeSet, fired first. */
+	FOnInventoryChangeSetNative OnInventoryChangeSetNative;
+
+	/** Fires once per committed AddItems/RemoveItems with every instance ID added, changed, or removed. Server only. */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Batch")
+	FOnInventoryBatchChanged OnInventoryBatchChanged;
+
 	/** Fires when an item is equipped into a slot. */
 	UPROPERTY(BlueprintAssignable, Category = "Inventory|Equipment")
 	FOnItemEquipped OnItemEquipped;
@@ -199,6 +371,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Inventory|Use")
 	FOnItemUsed OnItemUsed;
 
+	/** Fires when LoadInventory has replaced the inventory contents. Server only. */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory|Save")
+	FOnInventoryLoaded OnInventoryLoaded;
+
 	// ── Grid API (PoE-style spatial inventory) ─────────────────
 
 	/**
@@ -223,7 +399,9 @@ public:
 
 	/**
 	 * Move an existing inventory entry to a new grid position.
-	 * @return True if the move succeeded.
+	 * On the owning client the move is predicted: the local grid updates immediately, the request goes to the
+	 * server in the next batched RPC, and the entry snaps back if the server rejects it.
+	 * @return True if the move succeeded (or, on a client, the prediction was made).
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Grid")
 	bool MoveItem(int32 InstanceId, int32 NewX, int32 NewY);
@@ -238,6 +416,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Grid")
 	bool FindFreeSpace(const UOutlawItemDefinition* ItemDef, int32& OutX, int32& OutY) const;
 
+	/**
+	 * Repack every placed item to defragment the grid. Tries several largest-first orders, then spends what is left
+	 * of the budget perturbing the best one. The best layout found is committed as one batched update; nothing
+	 * changes if none beats the current layout.
+	 * @param TimeBudgetMs  Wall-time budget. At least one candidate layout is always tried.
+	 * @return True if items were moved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Grid")
+	bool AutoArrangeGrid(float TimeBudgetMs = 2.0f);
+
+	/**
+	 * Whether all of these items could be added together: stack top-ups, weight, then free slots or grid space.
+	 * Changes nothing, so it is safe for loot previews.
+	 * @param bAllowRearrange  Grid mode: also accept if they would fit after an AutoArrangeGrid-style repack.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool CanFitItems(const TArray<FOutlawItemAddRequest>& Requests, bool bAllowRearrange = false) const;
+
 	/** Get the item at a specific grid cell (returns the entry occupying that cell, if any). */
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Grid")
 	FOutlawInventoryEntry GetItemAtGridPosition(int32 X, int32 Y) const;
@@ -246,6 +442,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory|Grid")
 	bool IsGridMode() const;
 
+	/** True while this client has predicted moves or equips the server has not confirmed yet. */
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	bool HasPendingPredictions() const;
+
 	// ── Configuration ───────────────────────────────────────────
 
 	/** Maximum number of inventory slots (flat mode only, ignored in grid mode). */
@@ -256,6 +456,23 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory|Config")
 	float MaxWeight = 100.0f;
 
+	/**
+	 * Keep each distinct UseAbility granted while any item using it is in the inventory, so UseItem only activates
+	 * instead of granting and removing a spec per use. Avoids churning the ASC's abilities when consumables are spammed.
+	 * A use while the shared spec is still active gets a transient spec of its own, as without this option.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory|Config")
+	bool bPreGrantUseAbilities = false;
+
+	/**
+	 * Keep weapon state (ammo, quality, affixes, sockets, mods) inline in each entry, replicating with the fast array,
+	 * instead of one UOutlawItemInstance per weapon. An instance is only materialized while the weapon is equipped,
+	 * where its ability handles are needed, and folded back into the entry on unequip. Unequipping revokes the
+	 * installed mods' abilities and any affix effects the instance held; equipping grants them again.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory|Config")
+	bool bInlineWeaponState = false;
+
 	/**
 	 * Grid width in cells. Set > 0 to enable PoE-style grid inventory.
 	 * When 0, uses flat slot-based mode (Destiny/Outriders style).
@@ -268,13 +485,30 @@ public:
 	int32 InventoryGridHeight = 0;
 
 	/** Available equipment slots. Configure in the Blueprint defaults. */
-	UPROPERTY(EditDefaultsOnly, Replicated, BlueprintReadOnly, Category = "Inventory|Equipment")
+	UPROPERTY(EditDefaultsOnly, ReplicatedUsing = OnRep_EquipmentSlots, BlueprintReadOnly, Category = "Inventory|Equipment")
 	TArray<FOutlawEquipmentSlotInfo> EquipmentSlots;
 
+protected:
+	UFUNCTION()
+	void OnRep_EquipmentSlots();
+
 private:
 	/** Create an item instance for a weapon item definition. */
 	UOutlawItemInstance* CreateItemInstance(UOutlawItemDefinition* ItemDef, int32 InstanceId);
 
+	/** Fresh weapon state for a definition: full magazine, default socket layout. */
+	static FOutlawItemWeaponState MakeDefaultWeaponState(const UOutlawItemDefinition* ItemDef);
+
+	/** Give a new weapon entry its state: inline, or as an item instance outside bInlineWeaponState. */
+	void InitWeaponEntry(FOutlawInventoryEntry& Entry);
+
+	/** Weapon state described by a save record, on top of the definition's defaults. Resolve maps asset paths to objects. */
+	static FOutlawItemWeaponState MakeWeaponStateFromRecord(const UOutlawItemDefinition* ItemDef, const FOutlawInventoryItemSaveEntry& Record,
+		TFunctionRef<UObject*(const FSoftObjectPath&)> Resolve);
+
+	/** Overwrite a weapon entry's state, wherever it lives (existing instance, inline, or a new instance). */
+	void ApplyWeaponState(FOutlawInventoryEntry& Entry, const FOutlawItemWeaponState& State);
+
 	/** Notify the weapon manager when a weapon is equipped/unequipped. */
 	UOutlawWeaponManagerComponent* GetWeaponManager() const;
 
@@ -285,22 +519,266 @@ private:
 	FOutlawEquipmentSlotInfo* FindEquipmentSlot(FGameplayTag SlotTag);
 	const FOutlawEquipmentSlotInfo* FindEquipmentSlot(FGameplayTag SlotTag) const;
 
-	/** Broadcast inventory changed on both server and clients. */
+	/** Index into EquipmentSlots for a tag, INDEX_NONE if no such slot. Constant time via SlotIndexByTag. */
+	int32 FindEquipmentSlotIndex(FGameplayTag SlotTag) const;
+
+	/** Rebuild both slot maps from EquipmentSlots. Called at BeginPlay, on replication, and lazily if the array changed under them. */
+	void RebuildEquipmentSlotIndex() const;
+
+	/** Broadcast inventory changed. Server calls it directly; clients once per replication update via FlushReplicatedChanges. */
 	void BroadcastInventoryChanged();
 
+	// ── Cached totals ───────────────────────────────────────────
+
+	/** Fold an entry's current state into the cached totals. Called from AddEntry and PostReplicatedAdd. */
+	void AccountEntry(FOutlawInventoryEntry& Entry);
+
+	/** Remove an entry's previously accounted state from the cached totals. Called from RemoveEntry and PreReplicatedRemove. */
+	void UnaccountEntry(FOutlawInventoryEntry& Entry);
+
+	/** Re-fold an entry whose stack count or definition changed. Called on stack changes and PostReplicatedChange. */
+	void ReaccountEntry(FOutlawInventoryEntry& Entry);
+
+	/** Set an entry's stack count, keep the cached totals in sync, and mark the entry dirty. Server-only. */
+	void SetEntryStackCount(FOutlawInventoryEntry& Entry, int32 NewStackCount);
+
+	/** Add/remove an entry to/from the query indexes under the given definition. */
+	void IndexEntryQueries(int32 InstanceId, const UOutlawItemDefinition* ItemDef);
+	void UnindexEntryQueries(int32 InstanceId, const UOutlawItemDefinition* ItemDef);
+
+	// ── Pre-granted use abilities ───────────────────────────────
+
+	/** Reference the definition's UseAbility, granting it on the first reference. Called when a definition's first stack arrives. */
+	void AcquireUseAbility(const UOutlawItemDefinition* ItemDef);
+
+	/** Drop a reference taken by AcquireUseAbility, removing the spec (once it ends) on the last one. */
+	void ReleaseUseAbility(const UOutlawItemDefinition* ItemDef);
+
+	/** Handle of the pre-granted spec, granting it now if the ASC was not available when it was acquired. */
+	FGameplayAbilitySpecHandle FindOrGrantUseAbility(const UOutlawItemDefinition* ItemDef, UAbilitySystemComponent* ASC);
+
+	/** One granted UseAbility spec, shared by every definition in the inventory that uses the class. */
+	struct FGrantedUseAbility
+	{
+		FGameplayAbilitySpecHandle Handle;
+		int32 RefCount = 0;
+	};
+
+	/** Server only, and only when bPreGrantUseAbilities. */
+	TMap<TObjectKey<UClass>, FGrantedUseAbility> GrantedUseAbilities;
+
+	/** Indices into InventoryList.Entries ordered by SortOrder. */
+	void GetEntryIndicesInSortOrder(TArray<int32>& OutIndices) const;
+
+	/** Rank of each item definition's DisplayName in collation order. Rebuilt only when an unranked definition or a new culture shows up. */
+	void RefreshNameRanks();
+
+	TMap<TObjectKey<UOutlawItemDefinition>, int32> NameRankCache;
+	FString NameRankCulture;
+
+	/** Copy the entries for a set of instance IDs, in display order. Backs the Blueprint Find* queries. */
+	TArray<FOutlawInventoryEntry> CopyEntriesInOrder(TConstArrayView<int32> InstanceIds) const;
+
+	/** Builds with checks enabled (not Shipping): recompute all cached totals from scratch and ensure they match the incremental values. */
+	void VerifyCachedTotals() const;
+
 	/** Generate the next unique instance ID. Server-only. */
 	int32 GenerateInstanceId();
 
+	// ── Loading ─────────────────────────────────────────────────
+
+	/** Asset request completed (or ran synchronously): replace the inventory with PendingLoadData. */
+	void OnLoadInventoryAssetsReady();
+
+	/** Save data waiting on its asset batch. */
+	FOutlawInventorySaveData PendingLoadData;
+
+	/** Keeps the requested assets alive until the entries referencing them exist. */
+	TSharedPtr<FStreamableHandle> PendingLoadHandle;
+
+	/** FPlatformTime::Seconds() when the pending asset request was issued. */
+	double PendingLoadRequestTime = 0.0;
+
+	FOutlawInventoryLoadStats PendingLoadStats;
+	FOutlawInventoryLoadStats LastLoadStats;
+	bool bLoadPending = false;
+
+	/** True (and logs) if a load is pending, so the named mutation must be refused. */
+	bool RejectWhileLoading(const TCHAR* Operation) const;
+
+	// ── Client prediction ───────────────────────────────────────
+
+	/** Client halves of MoveItem/EquipItem/UnequipItem: validate against local state, apply, and queue for the server. */
+	bool PredictMoveItem(int32 InstanceId, int32 NewX, int32 NewY);
+	bool PredictEquipItem(int32 InstanceId);
+	bool PredictUnequipItem(FGameplayTag SlotTag);
+
+	/** Assign a prediction key, remember the op until acked, and schedule this frame's RPC. */
+	void QueuePrediction(FOutlawInventoryPredictedOp Op);
+
+	/** Send every op queued this frame in one ServerApplyPredictedOps. */
+	void SendPredictedOps();
+
+	/** Apply a client's predicted ops in order as one batch, then ack them. */
+	UFUNCTION(Server, Reliable)
+	void ServerApplyPredictedOps(const TArray<FOutlawInventoryPredictedOp>& Ops);
+
+	/** Every op up to LastKey has been processed; RejectedKeys were refused and must be rolled back. */
+	UFUNCTION(Client, Reliable)
+	void ClientAckPredictedOps(int32 LastKey, const TArray<int32>& RejectedKeys);
+
+	/** Record an entry's replicated grid position and retire confirmed moves it carries. Called from the replication callbacks. */
+	void ReceiveServerEntryState(FOutlawInventoryEntry& Entry);
+
+	/** Rebuild the predicted view: server state plus every unacknowledged op, in key order. */
+	void ReapplyPredictions();
+
+	/** True if the replicated state already shows the op's result. */
+	bool MatchesServerState(const FOutlawInventoryPredictedOp& Op) const;
+
+	/** Instance equipped in a slot as this machine sees it, predictions included. */
+	int32 GetEquippedInstanceId(FGameplayTag SlotTag) const;
+
+	struct FPendingPrediction
+	{
+		FOutlawInventoryPredictedOp Op;
+
+		/** Server accepted it but its result has not replicated yet; keep showing it until it does. */
+		bool bAccepted = false;
+	};
+
+	/** Sent or queued ops not yet settled, oldest first. */
+	TArray<FPendingPrediction> PendingPredictions;
+
+	/** Ops queued this frame, sent together on the next tick. */
+	TArray<FOutlawInventoryPredictedOp> UnsentPredictions;
+
+	/** Entries currently shown at a predicted grid position. */
+	TSet<int32> PredictedEntryIds;
+
+	/** Slot index -> predicted equipped InstanceId (INDEX_NONE for a predicted unequip), overriding EquipmentSlots. */
+	TMap<int32, int32> PredictedSlotIds;
+
+	int32 NextPredictionKey = 1;
+	bool bPredictionSendScheduled = false;
+
+	// ── Client replication ──────────────────────────────────────
+
+	/**
+	 * Move an entry's footprint on the client grid from where it was last stamped to its replicated position.
+	 * @return True if a previously stamped footprint moved.
+	 */
+	bool RestampReplicatedEntry(FOutlawInventoryEntry& Entry);
+
+	/** Clear an entry's last stamped footprint from the client grid. */
+	void UnstampReplicatedEntry(FOutlawInventoryEntry& Entry);
+
+	/** Queue one OnInventoryChanged for the end of the current replication update. */
+	void MarkReplicatedChangePending() { bReplicatedChangePending = true; }
+
+	/** Broadcast the queued change, if any. Called from FOutlawInventoryList::PostReplicatedReceive. */
+	void FlushReplicatedChanges();
+
+	bool bReplicatedChangePending = false;
+
+	// ── Change sets ─────────────────────────────────────────────
+
+	/** Accumulate change flags (OutlawInventoryChange::*) for an entry and schedule a flush for next tick. */
+	void NoteEntryChange(int32 InstanceId, uint8 ChangeFlags);
+
+	/** Record that entry order changed and schedule a flush. */
+	void NoteReorder();
+
+	/** Schedule FlushChangeSet for the next tick if not already pending. */
+	void ScheduleChangeSetFlush();
+
+	/** Resolve the accumulated flags into an FOutlawInventoryChangeSet and broadcast it. */
+	void FlushChangeSet();
+
+	/** Change flags per instance ID since the last flush, plus whether the ID existed at the start and exists now. */
+	TMap<int32, uint8> PendingEntryChanges;
+
+	bool bPendingReorder = false;
+	bool bChangeSetFlushScheduled = false;
+
+	// ── Save records ────────────────────────────────────────────
+
+	/** Last built save record for an entry, plus the item instance revision it was built from. */
+	struct FCachedSaveRecord
+	{
+		FOutlawInventoryItemSaveEntry Record;
+		uint32 InstanceRevision = 0;
+	};
+
+	/** Rebuild the cached record of every entry that is dirty, uncached or whose instance changed, noting it in SaveChangedIds. */
+	void RefreshSaveRecords();
+
+	/** Build a save record from scratch. EquippedSlotTag comes from the InstanceId -> slot map. */
+	FOutlawInventoryItemSaveEntry BuildSaveRecord(const FOutlawInventoryEntry& Entry, FGameplayTag EquippedSlotTag) const;
+
+	/** Flag an entry's save record stale. Server only. */
+	void MarkSaveDirty(int32 InstanceId);
+
+	/** Save record per InstanceId, reused by later saves until the entry is dirtied. */
+	TMap<int32, FCachedSaveRecord> SaveRecordCache;
+
+	/** Entries whose cached record is stale. */
+	TSet<int32> SaveDirtyIds;
+
+	/** Entries whose record was rebuilt since the committed baseline (the delta's upserts). */
+	TSet<int32> SaveChangedIds;
+
+	/** Entries removed since the committed baseline. */
+	TSet<int32> SaveRemovedIds;
+
+	/** Order changed (re-sort) since the committed baseline. */
+	bool bSaveOrderDirty = false;
+
+	// ── Batching ────────────────────────────────────────────────
+
+	/** Open a batch: change broadcasts and array-dirty marking are held until the matching EndBatch. Nestable. */
+	void BeginBatch();
+
+	/** Close a batch. The outermost close broadcasts once if anything changed. */
+	void EndBatch();
+
+	/** Record an entry touched inside a batch; remembers its pre-batch stack count for rollback. */
+	void NoteBatchChange(const FOutlawInventoryEntry& Entry);
+
+	/** Undo every add and stack change made since the outermost BeginBatch. Used by all-or-nothing AddItems. */
+	void RollbackBatchAdds();
+
+	int32 BatchDepth = 0;
+	bool bBatchBroadcastPending = false;
+
+	/** First instance ID generated inside the current batch; anything at or above it was created by the batch. */
+	int32 BatchFirstNewId = INDEX_NONE;
+
+	/** Instance IDs touched by the current batch, in first-touch order. */
+	TArray<int32> BatchAffectedIds;
+
+	/** Pre-batch stack counts of entries that existed before the batch and were changed by it. */
+	TMap<int32, int32> BatchOriginalStackCounts;
+
 	// ── Grid internals ──────────────────────────────────────────
 
-	/** Rebuild the occupancy grid from current entries. Call after load or replication changes in grid mode. */
+	/** Rebuild the occupancy grid from current entries. Call after load, or on a client whose grid was not sized yet when entries arrived. */
 	void RebuildOccupancyGrid();
 
+	/** Reset the occupancy grid to all-empty at the configured dimensions. */
+	void ResetOccupancyGrid();
+
 	/** Stamp/clear an item's footprint on the occupancy grid. */
 	void SetOccupancy(int32 GridX, int32 GridY, int32 W, int32 H, int32 InstanceId);
 	void ClearOccupancy(int32 GridX, int32 GridY, int32 W, int32 H);
 
-	/** Check if a rectangle is free, optionally ignoring one instance ID. */
+	/** Clear only the cells of the rectangle that still hold InstanceId. */
+	void ClearOccupancyOf(int32 GridX, int32 GridY, int32 W, int32 H, int32 InstanceId);
+
+	/** True once the occupancy grid matches the configured dimensions. */
+	bool IsOccupancyGridSized() const;
+
+	/** Check if a rectangle is free, optionally ignoring one instance ID's footprint. Bitmask test, a few word ANDs per row. */
 	bool IsRectFree(int32 X, int32 Y, int32 W, int32 H, int32 IgnoreInstanceId = INDEX_NONE) const;
 
 	/** Convert 2D grid coordinate to 1D index. */
@@ -313,6 +791,34 @@ private:
 	 */
 	TArray<int32> OccupancyGrid;
 
+	/** Bit-per-cell mirror of OccupancyGrid for fast rectangle tests and free-space search. Maintained by SetOccupancy/ClearOccupancy. */
+	FOutlawInventoryGridMask OccupancyMask;
+
+	/** Running count of INDEX_NONE cells in OccupancyGrid. Maintained by SetOccupancy/ClearOccupancy. */
+	int32 FreeGridCellCount = 0;
+
+	/** Running total of ItemDef->Weight * StackCount over all entries. Double to avoid drift from incremental updates. */
+	double CachedWeight = 0.0;
+
+	/** Per-definition stack index, maintained alongside the cached totals. Entries keep their definitions alive. */
+	TMap<const UOutlawItemDefinition*, FOutlawItemDefStacks> StacksByDef;
+
+	/** Query indexes (instance IDs, unordered), maintained alongside the cached totals. Keyed on the accounted definition. */
+	TMap<EOutlawItemType, TArray<int32>> IdsByType;
+	TMap<EOutlawItemRarity, TArray<int32>> IdsByRarity;
+	TMap<FGameplayTag, TArray<int32>> IdsBySlot;
+
+	/** Every item tag and each of its parents maps to the entries carrying it, so parent-tag queries are a single lookup. */
+	TMap<FGameplayTag, TArray<int32>> IdsByTag;
+
+	/** Slot tag -> index into EquipmentSlots. Slots are config-defined, so this only changes when the array does. */
+	mutable TMap<FGameplayTag, int32> SlotIndexByTag;
+
+	/** Equipped InstanceId -> index into EquipmentSlots. Kept in step by EquipItem/UnequipItem; rebuilt on clients on replication. */
+	mutable TMap<int32, int32> SlotIndexByInstanceId;
+
+	mutable bool bEquipmentSlotIndexBuilt = false;
+
 	/** The replicated inventory list. */
 	UPROPERTY(Replicated)
 	FOutlawInventoryList InventoryList;
@@ -0,0 +1,186 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OutlawInventoryGridMask.h"
+
+void FOutlawInventoryGridMask::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	WordsPerRow = (Width + 63) / 64;
+	Bits.Init(0, WordsPerRow * Height);
+}
+
+void FOutlawInventoryGridMask::SetRect(int32 X, int32 Y, int32 W, int32 H)
+{
+	WriteRect(X, Y, W, H, true);
+}
+
+void FOutlawInventoryGridMask::ClearRect(int32 X, int32 Y, int32 W, int32 H)
+{
+	WriteRect(X, Y, W, H, false);
+}
+
+bool FOutlawInventoryGridMask::IsOccupied(int32 X, int32 Y) const
+{
+	if (X < 0 || Y < 0 || X >= Width || Y >= Height)
+	{
+		return false;
+	}
+
+	return (RowWords(Y)[X >> 6] >> (X & 63)) & 1ull;
+}
+
+bool FOutlawInventoryGridMask::IsRectFree(int32 X, int32 Y, int32 W, int32 H) const
+{
+	if (X < 0 || Y < 0 || W <= 0 || H <= 0 || X + W > Width || Y + H > Height)
+	{
+		return false;
+	}
+
+	for (int32 Row = Y; Row < Y + H; ++Row)
+	{
+		if (FindLastSetInSpan(RowWords(Row), X, W) != INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FOutlawInventoryGridMask::IsRectFreeIgnoring(int32 X, int32 Y, int32 W, int32 H, const FIntRect& IgnoreRect) const
+{
+	if (X < 0 || Y < 0 || W <= 0 || H <= 0 || X + W > Width || Y + H > Height)
+	{
+		return false;
+	}
+
+	const int32 FirstWord = X >> 6;
+	const int32 LastWord = (X + W - 1) >> 6;
+
+	for (int32 Row = Y; Row < Y + H; ++Row)
+	{
+		const uint64* Words = RowWords(Row);
+		const bool bRowIgnored = Row >= IgnoreRect.Min.Y && Row < IgnoreRect.Max.Y;
+
+		for (int32 WordIdx = FirstWord; WordIdx <= LastWord; ++WordIdx)
+		{
+			uint64 Blocking = Words[WordIdx] & SpanBitsInWord(WordIdx, X, W);
+			if (bRowIgnored)
+			{
+				Blocking &= ~SpanBitsInWord(WordIdx, IgnoreRect.Min.X, IgnoreRect.Width());
+			}
+
+			if (Blocking)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FOutlawInventoryGridMask::FindFreeRect(int32 W, int32 H, int32& OutX, int32& OutY) const
+{
+	if (W <= 0 || H <= 0 || W > Width || H > Height)
+	{
+		return false;
+	}
+
+	// OR of the H rows under the current origin row: a set bit means that column is blocked somewhere in the band
+	TArray<uint64, TInlineAllocator<4>> Band;
+	Band.SetNumUninitialized(WordsPerRow);
+
+	for (int32 Y = 0; Y <= Height - H; ++Y)
+	{
+		FMemory::Memcpy(Band.GetData(), RowWords(Y), WordsPerRow * sizeof(uint64));
+		for (int32 Row = Y + 1; Row < Y + H; ++Row)
+		{
+			const uint64* Words = RowWords(Row);
+			for (int32 WordIdx = 0; WordIdx < WordsPerRow; ++WordIdx)
+			{
+				Band[WordIdx] |= Words[WordIdx];
+			}
+		}
+
+		int32 X = 0;
+		while (X <= Width - W)
+		{
+			const int32 Blocker = FindLastSetInSpan(Band.GetData(), X, W);
+			if (Blocker == INDEX_NONE)
+			{
+				OutX = X;
+				OutY = Y;
+				return true;
+			}
+
+			// Every origin up to and including Blocker would still overlap it
+			X = Blocker + 1;
+		}
+	}
+
+	return false;
+}
+
+uint64 FOutlawInventoryGridMask::SpanBitsInWord(int32 WordIdx, int32 X, int32 W)
+{
+	const int32 WordStart = WordIdx * 64;
+	const int32 Lo = FMath::Max(X, WordStart) - WordStart;
+	const int32 Hi = FMath::Min(X + W, WordStart + 64) - WordStart;
+	if (Hi <= Lo)
+	{
+		return 0;
+	}
+
+	const uint64 UpToHi = Hi >= 64 ? ~0ull : ((1ull << Hi) - 1);
+	const uint64 BelowLo = (1ull << Lo) - 1;
+	return UpToHi & ~BelowLo;
+}
+
+int32 FOutlawInventoryGridMask::FindLastSetInSpan(const uint64* Row, int32 X, int32 W) const
+{
+	const int32 FirstWord = X >> 6;
+	for (int32 WordIdx = (X + W - 1) >> 6; WordIdx >= FirstWord; --WordIdx)
+	{
+		const uint64 Hits = Row[WordIdx] & SpanBitsInWord(WordIdx, X, W);
+		if (Hits)
+		{
+			return WordIdx * 64 + static_cast<int32>(FMath::FloorLog2_64(Hits));
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void FOutlawInventoryGridMask::WriteRect(int32 X, int32 Y, int32 W, int32 H, bool bOccupied)
+{
+	const int32 MinX = FMath::Max(X, 0);
+	const int32 MinY = FMath::Max(Y, 0);
+	const int32 MaxX = FMath::Min(X + W, Width);
+	const int32 MaxY = FMath::Min(Y + H, Height);
+	if (MinX >= MaxX || MinY >= MaxY)
+	{
+		return;
+	}
+
+	const int32 FirstWord = MinX >> 6;
+	const int32 LastWord = (MaxX - 1) >> 6;
+
+	for (int32 Row = MinY; Row < MaxY; ++Row)
+	{
+		uint64* Words = RowWords(Row);
+		for (int32 WordIdx = FirstWord; WordIdx <= LastWord; ++WordIdx)
+		{
+			const uint64 Span = SpanBitsInWord(WordIdx, MinX, MaxX - MinX);
+			if (bOccupied)
+			{
+				Words[WordIdx] |= Span;
+			}
+			else
+			{
+				Words[WordIdx] &= ~Span;
+			}
+		}
+	}
+}
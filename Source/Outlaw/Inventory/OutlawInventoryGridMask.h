@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawInventoryGridMask — Bit-packed occupancy for grid inventories
+// ────────────────────────────────────────────────────────────────
+
+/**
+ * One bit per grid cell, packed into 64-bit words per row (rows wider than 64 cells span several words).
+ * Kept alongside the InstanceId grid so free-space tests are a handful of word ANDs instead of per-cell scans.
+ * Also usable standalone as a scratch board (e.g. for trial placements) since it holds no item references.
+ */
+struct OUTLAW_API FOutlawInventoryGridMask
+{
+	/** Resize to the given dimensions with every cell free. */
+	void Init(int32 InWidth, int32 InHeight);
+
+	/** Mark every cell of the rectangle occupied / free. Cells outside the grid are ignored. */
+	void SetRect(int32 X, int32 Y, int32 W, int32 H);
+	void ClearRect(int32 X, int32 Y, int32 W, int32 H);
+
+	/** True if the cell is inside the grid and occupied. */
+	bool IsOccupied(int32 X, int32 Y) const;
+
+	/** True if the rectangle lies inside the grid and none of its cells are occupied. */
+	bool IsRectFree(int32 X, int32 Y, int32 W, int32 H) const;
+
+	/** As IsRectFree, but cells covered by IgnoreRect count as free (used when moving an item over its own footprint). */
+	bool IsRectFreeIgnoring(int32 X, int32 Y, int32 W, int32 H, const FIntRect& IgnoreRect) const;
+
+	/**
+	 * Find the first origin, scanning top-to-bottom then left-to-right, where a W x H rectangle fits.
+	 * Same order as a brute-force scan, but skips past the rightmost blocking cell of each window.
+	 */
+	bool FindFreeRect(int32 W, int32 H, int32& OutX, int32& OutY) const;
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+private:
+	/** Bits of word WordIdx that fall inside the column span [X, X + W). */
+	static uint64 SpanBitsInWord(int32 WordIdx, int32 X, int32 W);
+
+	/** Highest column in [X, X + W) whose bit is set in Row, INDEX_NONE if the span is clear. */
+	int32 FindLastSetInSpan(const uint64* Row, int32 X, int32 W) const;
+
+	/** Set or clear the rectangle after clipping it to the grid. */
+	void WriteRect(int32 X, int32 Y, int32 W, int32 H, bool bOccupied);
+
+	const uint64* RowWords(int32 Y) const { return Bits.GetData() + Y * WordsPerRow; }
+	uint64* RowWords(int32 Y) { return Bits.GetData() + Y * WordsPerRow; }
+
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 WordsPerRow = 0;
+
+	/** Row-major: Height rows of WordsPerRow words. Bit (X & 63) of word (X >> 6) is column X. */
+	TArray<uint64> Bits;
+};
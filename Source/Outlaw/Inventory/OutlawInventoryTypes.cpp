@@ -0,0 +1,409 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OutlawInventoryTypes.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOutlawInventorySave, Log, All);
+
+// ════════════════════════════════════════════════════════════════
+// FOutlawInventorySaveData — Compact binary form
+// ════════════════════════════════════════════════════════════════
+
+namespace OutlawInventoryBinary
+{
+	constexpr uint8 ItemFlag_Grid     = 1 << 0;
+	constexpr uint8 ItemFlag_WideGrid = 1 << 1; // a coordinate above 255: X and Y written separately
+	constexpr uint8 ItemFlag_Equipped = 1 << 2;
+	constexpr uint8 ItemFlag_Weapon   = 1 << 3;
+	constexpr uint8 ItemFlag_Seeded   = 1 << 4; // weapon with a recorded affix seed (version 3+)
+
+	/** Deduplicates strings while writing. Index 0 is reserved for "none", so stored indices are 1-based. */
+	struct FStringTableWriter
+	{
+		TMap<FString, uint32> Indices;
+		TArray<FString> Strings;
+
+		uint32 Add(const FString& String)
+		{
+			if (String.IsEmpty())
+			{
+				return 0;
+			}
+
+			if (const uint32* Existing = Indices.Find(String))
+			{
+				return *Existing;
+			}
+
+			Strings.Add(String);
+			return Indices.Add(String, Strings.Num());
+		}
+
+		uint32 Add(const FSoftObjectPath& Path)
+		{
+			return Path.IsValid() ? Add(Path.ToString()) : 0;
+		}
+	};
+
+	void WritePacked(FArchive& Ar, uint32 Value)
+	{
+		Ar.SerializeIntPacked(Value);
+	}
+
+	uint32 ReadPacked(FArchive& Ar)
+	{
+		uint32 Value = 0;
+		Ar.SerializeIntPacked(Value);
+		return Value;
+	}
+
+	/** Map signed to unsigned so small negatives stay small when packed. */
+	uint32 ZigZag(int32 Value)
+	{
+		return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+	}
+
+	int32 UnZigZag(uint32 Value)
+	{
+		return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+	}
+
+	void WriteUtf8(FArchive& Ar, const FString& String)
+	{
+		const FTCHARToUTF8 Utf8(*String);
+		WritePacked(Ar, static_cast<uint32>(Utf8.Length()));
+		Ar.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+	}
+
+	bool ReadUtf8(FArchive& Ar, FString& OutString)
+	{
+		const uint32 Length = ReadPacked(Ar);
+		if (Ar.IsError() || Length > static_cast<uint32>(Ar.TotalSize() - Ar.Tell()))
+		{
+			return false;
+		}
+
+		TArray<ANSICHAR> Buffer;
+		Buffer.SetNumUninitialized(Length);
+		Ar.Serialize(Buffer.GetData(), Length);
+
+		const FUTF8ToTCHAR Converted(Buffer.GetData(), Length);
+		OutString = FString::ConstructFromPtrSize(Converted.Get(), Converted.Length());
+		return !Ar.IsError();
+	}
+}
+
+void FOutlawInventorySaveData::SaveToBinary(TArray<uint8>& OutBytes) const
+{
+	using namespace OutlawInventoryBinary;
+
+	// Items first into their own buffer: the string table is only complete once every item has been visited
+	FStringTableWriter Table;
+	TArray<uint8> ItemBytes;
+	FMemoryWriter ItemAr(ItemBytes);
+
+	WritePacked(ItemAr, Items.Num());
+	for (const FOutlawInventoryItemSaveEntry& Item : Items)
+	{
+		const bool bGrid = Item.GridX != INDEX_NONE && Item.GridY != INDEX_NONE;
+		const bool bWideGrid = bGrid && (Item.GridX < 0 || Item.GridY < 0 || Item.GridX > 255 || Item.GridY > 255);
+		const bool bSeeded = Item.AffixSeed != 0;
+		const bool bWeapon = bSeeded || Item.CurrentAmmo != 0 || Item.Quality != 0 || Item.SavedAffixes.Num() > 0
+			|| Item.SavedSocketedGems.Num() > 0 || Item.SavedModTier1.IsValid() || Item.SavedModTier2.IsValid();
+
+		uint8 Flags = 0;
+		Flags |= bGrid ? ItemFlag_Grid : 0;
+		Flags |= bWideGrid ? ItemFlag_WideGrid : 0;
+		Flags |= Item.EquippedSlotTag.IsValid() ? ItemFlag_Equipped : 0;
+		Flags |= bWeapon ? ItemFlag_Weapon : 0;
+		Flags |= bSeeded ? ItemFlag_Seeded : 0;
+
+		ItemAr << Flags;
+		WritePacked(ItemAr, Table.Add(Item.ItemDefPath));
+		WritePacked(ItemAr, ZigZag(Item.StackCount));
+		WritePacked(ItemAr, ZigZag(Item.InstanceId));
+
+		if (bWideGrid)
+		{
+			WritePacked(ItemAr, ZigZag(Item.GridX));
+			WritePacked(ItemAr, ZigZag(Item.GridY));
+		}
+		else if (bGrid)
+		{
+			WritePacked(ItemAr, (static_cast<uint32>(Item.GridY) << 8) | static_cast<uint32>(Item.GridX));
+		}
+
+		if (Flags & ItemFlag_Equipped)
+		{
+			WritePacked(ItemAr, Table.Add(Item.EquippedSlotTag.ToString()));
+		}
+
+		if (bWeapon)
+		{
+			WritePacked(ItemAr, ZigZag(Item.CurrentAmmo));
+			WritePacked(ItemAr, ZigZag(Item.Quality));
+
+			WritePacked(ItemAr, Item.SavedAffixes.Num());
+			for (const FOutlawSavedAffix& Affix : Item.SavedAffixes)
+			{
+				WritePacked(ItemAr, (Table.Add(Affix.AffixDefPath) << 1) | (Affix.Slot & 1));
+				float RolledValue = Affix.RolledValue;
+				ItemAr << RolledValue;
+			}
+
+			WritePacked(ItemAr, Item.SavedSocketedGems.Num());
+			for (const FSoftObjectPath& Gem : Item.SavedSocketedGems)
+			{
+				WritePacked(ItemAr, Table.Add(Gem));
+			}
+
+			WritePacked(ItemAr, Table.Add(Item.SavedModTier1));
+			WritePacked(ItemAr, Table.Add(Item.SavedModTier2));
+
+			if (bSeeded)
+			{
+				// Seeds are uniformly random: packing would only grow them
+				int64 Seed = Item.AffixSeed;
+				ItemAr << Seed;
+				WritePacked(ItemAr, ZigZag(Item.AffixItemLevel));
+			}
+		}
+	}
+
+	OutBytes.Reset();
+	FMemoryWriter Ar(OutBytes);
+
+	uint32 Magic = BinaryMagic;
+	uint32 Version = BinaryVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	WritePacked(Ar, Table.Strings.Num());
+	for (const FString& String : Table.Strings)
+	{
+		WriteUtf8(Ar, String);
+	}
+
+	Ar.Serialize(ItemBytes.GetData(), ItemBytes.Num());
+}
+
+bool FOutlawInventorySaveData::LoadFromBinary(TConstArrayView<uint8> Bytes)
+{
+	using namespace OutlawInventoryBinary;
+
+	FMemoryReaderView Ar(Bytes);
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsError() || Magic != BinaryMagic)
+	{
+		UE_LOG(LogOutlawInventorySave, Warning, TEXT("LoadFromBinary: not an inventory save blob"));
+		return false;
+	}
+	if (Version == 0 || Version > BinaryVersion)
+	{
+		UE_LOG(LogOutlawInventorySave, Warning, TEXT("LoadFromBinary: unsupported version %u (current %u)"), Version, BinaryVersion);
+		return false;
+	}
+
+	// Every table entry and item takes at least one byte; reject counts the blob cannot possibly hold
+	auto ReadCount = [&Ar]() -> int32
+	{
+		const uint32 Count = ReadPacked(Ar);
+		return (Ar.IsError() || Count > static_cast<uint32>(Ar.TotalSize() - Ar.Tell())) ? INDEX_NONE : static_cast<int32>(Count);
+	};
+
+	const int32 StringCount = ReadCount();
+	if (StringCount == INDEX_NONE)
+	{
+		return false;
+	}
+
+	TArray<FString> Strings;
+	Strings.SetNum(StringCount);
+	for (FString& String : Strings)
+	{
+		if (!ReadUtf8(Ar, String))
+		{
+			return false;
+		}
+	}
+
+	bool bBadIndex = false;
+	auto LookUp = [&Strings, &bBadIndex](uint32 Index) -> const FString*
+	{
+		if (Index == 0)
+		{
+			return nullptr;
+		}
+		if (Index > static_cast<uint32>(Strings.Num()))
+		{
+			bBadIndex = true;
+			return nullptr;
+		}
+		return &Strings[Index - 1];
+	};
+	auto LookUpPath = [&LookUp](uint32 Index) -> FSoftObjectPath
+	{
+		const FString* String = LookUp(Index);
+		return String ? FSoftObjectPath(*String) : FSoftObjectPath();
+	};
+
+	const int32 ItemCount = ReadCount();
+	if (ItemCount == INDEX_NONE)
+	{
+		return false;
+	}
+
+	TArray<FOutlawInventoryItemSaveEntry> LoadedItems;
+	LoadedItems.Reserve(ItemCount);
+
+	for (int32 ItemIdx = 0; ItemIdx < ItemCount && !Ar.IsError() && !bBadIndex; ++ItemIdx)
+	{
+		FOutlawInventoryItemSaveEntry& Item = LoadedItems.AddDefaulted_GetRef();
+
+		uint8 Flags = 0;
+		Ar << Flags;
+		Item.ItemDefPath = LookUpPath(ReadPacked(Ar));
+		Item.StackCount = UnZigZag(ReadPacked(Ar));
+		if (Version >= 2)
+		{
+			Item.InstanceId = UnZigZag(ReadPacked(Ar));
+		}
+
+		if (Flags & ItemFlag_WideGrid)
+		{
+			Item.GridX = UnZigZag(ReadPacked(Ar));
+			Item.GridY = UnZigZag(ReadPacked(Ar));
+		}
+		else if (Flags & ItemFlag_Grid)
+		{
+			const uint32 Packed = ReadPacked(Ar);
+			Item.GridX = static_cast<int32>(Packed & 0xFF);
+			Item.GridY = static_cast<int32>(Packed >> 8);
+		}
+
+		if (Flags & ItemFlag_Equipped)
+		{
+			if (const FString* TagName = LookUp(ReadPacked(Ar)))
+			{
+				Item.EquippedSlotTag = FGameplayTag::RequestGameplayTag(FName(**TagName), false);
+			}
+		}
+
+		if (Flags & ItemFlag_Weapon)
+		{
+			Item.CurrentAmmo = UnZigZag(ReadPacked(Ar));
+			Item.Quality = UnZigZag(ReadPacked(Ar));
+
+			const int32 AffixCount = ReadCount();
+			if (AffixCount == INDEX_NONE)
+			{
+				return false;
+			}
+			Item.SavedAffixes.SetNum(AffixCount);
+			for (FOutlawSavedAffix& Affix : Item.SavedAffixes)
+			{
+				const uint32 Packed = ReadPacked(Ar);
+				Affix.AffixDefPath = LookUpPath(Packed >> 1);
+				Affix.Slot = static_cast<uint8>(Packed & 1);
+				Ar << Affix.RolledValue;
+			}
+
+			const int32 GemCount = ReadCount();
+			if (GemCount == INDEX_NONE)
+			{
+				return false;
+			}
+			Item.SavedSocketedGems.SetNum(GemCount);
+			for (FSoftObjectPath& Gem : Item.SavedSocketedGems)
+			{
+				Gem = LookUpPath(ReadPacked(Ar));
+			}
+
+			Item.SavedModTier1 = LookUpPath(ReadPacked(Ar));
+			Item.SavedModTier2 = LookUpPath(ReadPacked(Ar));
+
+			if (Version >= 3 && (Flags & ItemFlag_Seeded))
+			{
+				Ar << Item.AffixSeed;
+				Item.AffixItemLevel = UnZigZag(ReadPacked(Ar));
+			}
+		}
+	}
+
+	if (Ar.IsError() || bBadIndex)
+	{
+		UE_LOG(LogOutlawInventorySave, Warning, TEXT("LoadFromBinary: truncated or corrupt data"));
+		return false;
+	}
+
+	Items = MoveTemp(LoadedItems);
+	return true;
+}
+
+// ════════════════════════════════════════════════════════════════
+// FOutlawInventorySaveData — Delta compaction
+// ════════════════════════════════════════════════════════════════
+
+void FOutlawInventorySaveData::ApplyDelta(const FOutlawInventorySaveDelta& Delta)
+{
+	if (Delta.RemovedInstanceIds.Num() > 0)
+	{
+		const TSet<int32> Removed(Delta.RemovedInstanceIds);
+		Items.RemoveAll([&Removed](const FOutlawInventoryItemSaveEntry& Item)
+		{
+			return Item.InstanceId != INDEX_NONE && Removed.Contains(Item.InstanceId);
+		});
+	}
+
+	if (Delta.Upserts.Num() > 0)
+	{
+		TMap<int32, int32> IndexById;
+		IndexById.Reserve(Items.Num());
+		for (int32 Idx = 0; Idx < Items.Num(); ++Idx)
+		{
+			if (Items[Idx].InstanceId != INDEX_NONE)
+			{
+				IndexById.Add(Items[Idx].InstanceId, Idx);
+			}
+		}
+
+		for (const FOutlawInventoryItemSaveEntry& Upsert : Delta.Upserts)
+		{
+			if (const int32* Existing = IndexById.Find(Upsert.InstanceId))
+			{
+				Items[*Existing] = Upsert;
+			}
+			else
+			{
+				const int32 NewIdx = Items.Add(Upsert);
+				if (Upsert.InstanceId != INDEX_NONE)
+				{
+					IndexById.Add(Upsert.InstanceId, NewIdx);
+				}
+			}
+		}
+	}
+
+	if (Delta.Order.Num() > 0)
+	{
+		TMap<int32, int32> Rank;
+		Rank.Reserve(Delta.Order.Num());
+		for (int32 Idx = 0; Idx < Delta.Order.Num(); ++Idx)
+		{
+			Rank.Add(Delta.Order[Idx], Idx);
+		}
+
+		// Records the order does not mention keep their relative position after everything it does
+		Items.StableSort([&Rank](const FOutlawInventoryItemSaveEntry& A, const FOutlawInventoryItemSaveEntry& B)
+		{
+			const int32* RankA = Rank.Find(A.InstanceId);
+			const int32* RankB = Rank.Find(B.InstanceId);
+			return (RankA ? *RankA : MAX_int32) < (RankB ? *RankB : MAX_int32);
+		});
+	}
+}
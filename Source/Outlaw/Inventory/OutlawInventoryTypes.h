@@ -6,6 +6,7 @@
 #include "GameplayTagContainer.h"
 #include "Net/Serialization/FastArraySerializer.h"
 #include "AbilitySystem/OutlawAbilityTypes.h"
+#include "Weapon/OutlawWeaponTypes.h"
 #include "OutlawInventoryTypes.generated.h"
 
 class UOutlawItemDefinition;
@@ -53,16 +54,91 @@ struct FOutlawInventoryEntry : public FFastArraySerializerItem
 	UPROPERTY(BlueprintReadOnly, Category = "Inventory|Grid")
 	int32 GridY;
 
-	/** Per-item mutable state (ammo, affixes, gems, etc.). Only set for weapons. */
+	/**
+	 * Per-item mutable state (ammo, affixes, gems, etc.). Only set for weapons.
+	 * With the component's bInlineWeaponState, only set while the weapon is equipped.
+	 */
 	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
 	TObjectPtr<UOutlawItemInstance> ItemInstance;
 
+	/**
+	 * Weapon state kept inline, replicating with the entry, when the component's bInlineWeaponState is set.
+	 * While the weapon is equipped its materialized ItemInstance is authoritative and this copy is stale.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	FOutlawItemWeaponState WeaponState;
+
+	/**
+	 * Display position in the inventory, ascending. The fast array does not preserve element order on clients,
+	 * so order is replicated per entry: a sort only resends the entries whose position actually changed.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 SortOrder = 0;
+
+	// ── Owner-side bookkeeping (not replicated) ─────────────────
+	// The state last folded into the owning component's cached totals. Lets replication
+	// callbacks apply deltas instead of recomputing from scratch.
+
+	const UOutlawItemDefinition* AccountedItemDef = nullptr;
+	int32 AccountedStackCount = 0;
+
+	// Footprint last stamped into the occupancy grid, so client-side moves and removals
+	// clear exactly what this entry stamped instead of rebuilding the whole grid.
+
+	int32 StampedGridX = INDEX_NONE;
+	int32 StampedGridY = INDEX_NONE;
+	int32 StampedGridW = 0;
+	int32 StampedGridH = 0;
+
+	// SortOrder as last seen by the client callbacks, to tell reorders apart from content changes.
+
+	int32 SeenSortOrder = INDEX_NONE;
+
+	// Inline weapon state only: the instance dropped on unequip had affix effects granted, so the
+	// next EquipItem grants them again on the rebuilt instance.
+
+	bool bInlineAffixEffectsGranted = false;
+
+	// Grid position as last received from the server. A client-predicted move changes GridX/GridY
+	// only, so this is what the entry falls back to when the prediction is rejected.
+
+	int32 ServerGridX = INDEX_NONE;
+	int32 ServerGridY = INDEX_NONE;
+
 	// FFastArraySerializerItem callbacks
 	void PreReplicatedRemove(const struct FOutlawInventoryList& InArraySerializer);
 	void PostReplicatedAdd(const struct FOutlawInventoryList& InArraySerializer);
 	void PostReplicatedChange(const struct FOutlawInventoryList& InArraySerializer);
 };
 
+// ────────────────────────────────────────────────────────────────
+// FOutlawInventoryHotFields — Packed copies of per-entry definition fields
+// ────────────────────────────────────────────────────────────────
+
+/**
+ * Structure-of-arrays mirror of the item definition fields that inner loops read, index-parallel with
+ * FOutlawInventoryList::Entries. Sorting, grid stamping, packing and weight verification stream through these
+ * contiguous arrays instead of chasing each entry's ItemDef into its data asset. Not replicated.
+ */
+struct OUTLAW_API FOutlawInventoryHotFields
+{
+	TArray<float> UnitWeight;
+	TArray<int16> GridWidth;
+	TArray<int16> GridHeight;
+	/** 0 marks an entry without a definition; every other field is then zero too. */
+	TArray<int32> MaxStackSize;
+	TArray<uint8> Rarity;
+	TArray<uint8> ItemType;
+
+	int32 Num() const { return MaxStackSize.Num(); }
+	bool HasDef(int32 Index) const { return MaxStackSize[Index] > 0; }
+
+	/** Append the fields of one entry's definition (null allowed). */
+	void Add(const UOutlawItemDefinition* ItemDef);
+	void RemoveAt(int32 Index);
+	void Reset(int32 Slack = 0);
+};
+
 // ────────────────────────────────────────────────────────────────
 // FOutlawInventoryList — Replicated array of inventory entries
 // ────────────────────────────────────────────────────────────────
@@ -87,16 +163,47 @@ struct FOutlawInventoryList : public FFastArraySerializer
 		return FFastArraySerializer::FastArrayDeltaSerialize<FOutlawInventoryEntry, FOutlawInventoryList>(Entries, DeltaParms, *this);
 	}
 
+	/** Called once after all item callbacks of a received update; flushes the owner's deferred change broadcast. */
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+
 	/** Add an entry and mark the array dirty. Returns the new entry's index. GridX/GridY default to INDEX_NONE (flat mode). */
 	int32 AddEntry(UOutlawItemDefinition* ItemDef, int32 StackCount, int32 InstanceId, int32 GridX = INDEX_NONE, int32 GridY = INDEX_NONE);
 
 	/** Remove an entry by instance ID. Returns true if found and removed. */
 	bool RemoveEntry(int32 InstanceId);
 
-	/** Find an entry by instance ID. Returns nullptr if not found. */
+	/** Remove the entry at the given array index and mark the array dirty. */
+	void RemoveEntryAt(int32 Index);
+
+	/** Remove all entries and mark the array dirty. */
+	void ResetEntries();
+
+	/** SortOrder for the next added entry: new entries go to the end. Server-only. */
+	int32 NextSortOrder = 0;
+
+	/** Find an entry by instance ID. Returns nullptr if not found. O(1). */
 	FOutlawInventoryEntry* FindEntry(int32 InstanceId);
 	const FOutlawInventoryEntry* FindEntry(int32 InstanceId) const;
 
+	/** Array index of the entry with the given instance ID, INDEX_NONE if not found. O(1). */
+	int32 IndexOfEntry(int32 InstanceId) const;
+
+	/** Rebuild the InstanceId -> index map and the hot fields from Entries. Call after reordering Entries in place. */
+	void RebuildInstanceIndex() const;
+
+	/** Packed definition fields, index-parallel with Entries. Rebuilt first if stale. */
+	const FOutlawInventoryHotFields& GetHotFields() const;
+
+	/**
+	 * Flag the InstanceId -> index map as stale so the next lookup rebuilds it.
+	 * Used by the client replication callbacks: the fast array swap-removes entries, so indices shift unpredictably.
+	 */
+	void InvalidateInstanceIndex() const { bInstanceIndexDirty = true; }
+
+	/** Hold back MarkArrayDirty from removals until the matching EndDeferredArrayDirty, which marks once. Nestable. */
+	void BeginDeferredArrayDirty() { ++DeferArrayDirtyDepth; }
+	void EndDeferredArrayDirty();
+
 	/** All inventory entries. */
 	UPROPERTY()
 	TArray<FOutlawInventoryEntry> Entries;
@@ -104,6 +211,22 @@ struct FOutlawInventoryList : public FFastArraySerializer
 	/** Back-pointer to the owning component. */
 	UPROPERTY(NotReplicated)
 	TObjectPtr<UOutlawInventoryComponent> OwnerComponent;
+
+private:
+	/** InstanceId -> index into Entries. Not replicated; maintained eagerly on the server, rebuilt lazily when invalidated. */
+	mutable TMap<int32, int32> InstanceIndex;
+
+	/** Maintained and invalidated together with InstanceIndex. */
+	mutable FOutlawInventoryHotFields HotFields;
+
+	/** True when InstanceIndex (and HotFields) no longer match Entries and must be rebuilt before the next lookup. */
+	mutable bool bInstanceIndexDirty = false;
+
+	/** Mark the array dirty now, or remember to once the outermost deferral ends. */
+	void MarkArrayDirtyOrDefer();
+
+	int32 DeferArrayDirtyDepth = 0;
+	bool bArrayDirtyPending = false;
 };
 
 /** Enable NetDeltaSerialize for FOutlawInventoryList. */
@@ -116,6 +239,165 @@ struct TStructOpsTypeTraits<FOutlawInventoryList> : public TStructOpsTypeTraitsB
 	};
 };
 
+// ────────────────────────────────────────────────────────────────
+// FOutlawItemDefStacks — Secondary index of entries per item definition
+// ────────────────────────────────────────────────────────────────
+
+/** Every entry holding one item definition, so stacking, counting and removal by definition skip unrelated entries. */
+struct FOutlawItemDefStacks
+{
+	/** Instance IDs of all entries with this definition, oldest first. IDs rather than indices: indices shift on removal. */
+	TArray<int32> InstanceIds;
+
+	/** Subset of InstanceIds whose StackCount is below the definition's MaxStackSize. */
+	TArray<int32> OpenStackIds;
+
+	/** Sum of StackCount across InstanceIds. */
+	int32 TotalCount = 0;
+};
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawInventoryChangeSet — Coalesced per-frame delta of inventory entries
+// ────────────────────────────────────────────────────────────────
+
+/** Which entries changed since the last flush, so list/grid widgets can patch only the affected tiles. */
+USTRUCT(BlueprintType)
+struct FOutlawInventoryChangeSet
+{
+	GENERATED_BODY()
+
+	/** Entries that appeared. */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<int32> Added;
+
+	/**
+	 * Entries that disappeared. An entry added and removed within the same frame is not reported at all.
+	 * An ID removed and then reused within the frame (e.g. by LoadInventory) is in both Removed and Added:
+	 * drop the old tile first, then build the new one.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<int32> Removed;
+
+	/** Entries whose stack count, definition or item state changed. Never also in Added or Removed. */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<int32> Changed;
+
+	/** Entries whose grid position changed. Never also in Added or Removed. */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<int32> Moved;
+
+	/** True if entry order changed (e.g. SortInventory); order-sensitive lists should re-read the entries. */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	bool bReordered = false;
+
+	bool IsEmpty() const
+	{
+		return Added.IsEmpty() && Removed.IsEmpty() && Changed.IsEmpty() && Moved.IsEmpty() && !bReordered;
+	}
+};
+
+// ────────────────────────────────────────────────────────────────
+// Batch add/remove — Request and result types for AddItems / RemoveItems
+// ────────────────────────────────────────────────────────────────
+
+/** How a batch reacts when some of its requests cannot be fully satisfied. */
+UENUM(BlueprintType)
+enum class EOutlawInventoryBatchMode : uint8
+{
+	/** Apply every request in full or change nothing. */
+	AllOrNothing,
+
+	/** Apply as much of each request as fits; per-request results report what happened. */
+	BestEffort
+};
+
+USTRUCT(BlueprintType)
+struct FOutlawItemAddRequest
+{
+	GENERATED_BODY()
+
+	/** The item to add. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	TObjectPtr<UOutlawItemDefinition> ItemDef = nullptr;
+
+	/** Number of items to add. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	int32 Count = 1;
+};
+
+USTRUCT(BlueprintType)
+struct FOutlawItemRemoveRequest
+{
+	GENERATED_BODY()
+
+	/** Entry to remove from. When INDEX_NONE, items are drawn from any stacks of ItemDef instead. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	int32 InstanceId = INDEX_NONE;
+
+	/** Item type to remove when InstanceId is INDEX_NONE. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	TObjectPtr<UOutlawItemDefinition> ItemDef = nullptr;
+
+	/** Number of items to remove. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory")
+	int32 Count = 1;
+};
+
+/** Outcome of one request in a batch, at the same index as the request. */
+USTRUCT(BlueprintType)
+struct FOutlawItemBatchResult
+{
+	GENERATED_BODY()
+
+	/** Items actually added or removed for this request. 0 for every request when an all-or-nothing batch fails. */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	int32 Applied = 0;
+
+	/** Instance IDs of entries this request created (adds only). */
+	UPROPERTY(BlueprintReadOnly, Category = "Inventory")
+	TArray<int32> CreatedInstanceIds;
+};
+
+// ────────────────────────────────────────────────────────────────
+// Client prediction — Operations a client applies locally and sends to the server
+// ────────────────────────────────────────────────────────────────
+
+UENUM()
+enum class EOutlawInventoryPredictedOpType : uint8
+{
+	Move,
+	Equip,
+	Unequip
+};
+
+USTRUCT()
+struct FOutlawInventoryPredictedOp
+{
+	GENERATED_BODY()
+
+	/** Client-assigned, increasing per component. The server acks the highest key it processed. */
+	UPROPERTY()
+	int32 PredictionKey = 0;
+
+	UPROPERTY()
+	EOutlawInventoryPredictedOpType Type = EOutlawInventoryPredictedOpType::Move;
+
+	/** Entry moved or equipped. Unused for Unequip. */
+	UPROPERTY()
+	int32 InstanceId = INDEX_NONE;
+
+	/** Move target. */
+	UPROPERTY()
+	int32 GridX = INDEX_NONE;
+
+	UPROPERTY()
+	int32 GridY = INDEX_NONE;
+
+	/** Slot equipped into or unequipped. */
+	UPROPERTY()
+	FGameplayTag SlotTag;
+};
+
 // ────────────────────────────────────────────────────────────────
 // FOutlawEquipmentSlotInfo — Tracks what's equipped in each slot
 // ────────────────────────────────────────────────────────────────
@@ -182,6 +464,10 @@ struct FOutlawInventoryItemSaveEntry
 	UPROPERTY(BlueprintReadWrite, Category = "Save")
 	int32 StackCount = 0;
 
+	/** Runtime InstanceId when saved. Restored on load when unique so deltas stay keyed across sessions. */
+	UPROPERTY(BlueprintReadWrite, Category = "Save")
+	int32 InstanceId = INDEX_NONE;
+
 	/** Equipment slot tag if this item was equipped, empty otherwise. */
 	UPROPERTY(BlueprintReadWrite, Category = "Save")
 	FGameplayTag EquippedSlotTag;
@@ -219,6 +505,76 @@ struct FOutlawInventoryItemSaveEntry
 	/** Saved Tier 2 mod path. */
 	UPROPERTY(BlueprintReadWrite, Category = "Save|Weapon")
 	FSoftObjectPath SavedModTier2;
+
+	/** Seed the affixes were rolled from (0 if never rolled), so they can be regenerated and verified. */
+	UPROPERTY(BlueprintReadWrite, Category = "Save|Weapon")
+	int64 AffixSeed = 0;
+
+	/** Item level the affixes were rolled at. */
+	UPROPERTY(BlueprintReadWrite, Category = "Save|Weapon")
+	int32 AffixItemLevel = 0;
+};
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawInventoryLoadStats — Phase timings of the last LoadInventory
+// ────────────────────────────────────────────────────────────────
+
+USTRUCT(BlueprintType)
+struct FOutlawInventoryLoadStats
+{
+	GENERATED_BODY()
+
+	/** Time spent collecting unique asset paths from the save data. */
+	UPROPERTY(BlueprintReadOnly, Category = "Save")
+	float GatherSeconds = 0.0f;
+
+	/** Wall time from issuing the asset request to its completion (spans frames when async). */
+	UPROPERTY(BlueprintReadOnly, Category = "Save")
+	float AssetLoadSeconds = 0.0f;
+
+	/** Time spent clearing the old inventory and creating entries and item instances. */
+	UPROPERTY(BlueprintReadOnly, Category = "Save")
+	float MaterializeSeconds = 0.0f;
+
+	/** Time spent re-equipping saved equipment. */
+	UPROPERTY(BlueprintReadOnly, Category = "Save")
+	float EquipSeconds = 0.0f;
+
+	/** Distinct asset paths requested. */
+	UPROPERTY(BlueprintReadOnly, Category = "Save")
+	int32 UniqueAssetCount = 0;
+
+	/** Entries restored. */
+	UPROPERTY(BlueprintReadOnly, Category = "Save")
+	int32 ItemCount = 0;
+
+	/** True if assets were loaded through the synchronous fallback. */
+	UPROPERTY(BlueprintReadOnly, Category = "Save")
+	bool bSynchronous = false;
+};
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawInventorySaveDelta — Changes since the previous save
+// ────────────────────────────────────────────────────────────────
+
+USTRUCT(BlueprintType)
+struct FOutlawInventorySaveDelta
+{
+	GENERATED_BODY()
+
+	/** Records for entries added or changed since the previous save, keyed by their InstanceId. */
+	UPROPERTY(BlueprintReadWrite, Category = "Save")
+	TArray<FOutlawInventoryItemSaveEntry> Upserts;
+
+	/** InstanceIds of entries removed since the previous save. */
+	UPROPERTY(BlueprintReadWrite, Category = "Save")
+	TArray<int32> RemovedInstanceIds;
+
+	/** Full InstanceId order, only filled when the inventory was re-sorted. Empty means order is unchanged. */
+	UPROPERTY(BlueprintReadWrite, Category = "Save")
+	TArray<int32> Order;
+
+	bool IsEmpty() const { return Upserts.IsEmpty() && RemovedInstanceIds.IsEmpty() && Order.IsEmpty(); }
 };
 
 // ────────────────────────────────────────────────────────────────
@@ -232,4 +588,27 @@ struct FOutlawInventorySaveData
 
 	UPROPERTY(BlueprintReadWrite, Category = "Save")
 	TArray<FOutlawInventoryItemSaveEntry> Items;
+
+	// ── Compact binary form ─────────────────────────────────────
+	// Layout: magic, version, a deduplicated string table (asset paths and slot tag names, UTF-8),
+	// then the items. Counts and table indices are packed ints; grid X/Y share one packed int;
+	// an affix's prefix/suffix bit rides in the low bit of its table index.
+
+	static constexpr uint32 BinaryMagic = 0x564E494F; // "OINV"
+	// Version 2 adds the InstanceId after the stack count; version 1 blobs load with INDEX_NONE.
+	// Version 3 adds the affix seed and level after the weapon mods, behind their own item flag.
+	static constexpr uint32 BinaryVersion = 3;
+
+	/** Encode into the compact binary form. */
+	void SaveToBinary(TArray<uint8>& OutBytes) const;
+
+	/** Decode the compact binary form. Returns false and leaves this untouched on malformed or unsupported data. */
+	bool LoadFromBinary(TConstArrayView<uint8> Bytes);
+
+	/**
+	 * Fold a delta into this snapshot: upserts replace the record with the same InstanceId (or append),
+	 * removals drop records, and a non-empty Order re-sorts. Applying successive deltas in order compacts them
+	 * into a full save equivalent to SaveInventory() at the time of the last delta.
+	 */
+	void ApplyDelta(const FOutlawInventorySaveDelta& Delta);
 };
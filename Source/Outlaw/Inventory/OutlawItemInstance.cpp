@@ -3,20 +3,237 @@
 #include "OutlawItemInstance.h"
 #include "OutlawItemDefinition.h"
 #include "AbilitySystemComponent.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectComponents/AbilitiesGameplayEffectComponent.h"
+#include "GameplayEffectComponents/AdditionalEffectsGameplayEffectComponent.h"
+#include "GameplayEffectComponents/BlockAbilityTagsGameplayEffectComponent.h"
+#include "GameplayEffectComponents/ChanceToApplyGameplayEffectComponent.h"
+#include "GameplayEffectComponents/CustomCanApplyGameplayEffectComponent.h"
+#include "GameplayEffectComponents/ImmunityGameplayEffectComponent.h"
+#include "GameplayEffectComponents/RemoveOtherGameplayEffectComponent.h"
+#include "GameplayEffectComponents/TargetTagRequirementsGameplayEffectComponent.h"
+#include "GameplayEffectComponents/TargetTagsGameplayEffectComponent.h"
 #include "AbilitySystem/OutlawAbilitySet.h"
 #include "Weapon/OutlawAffixDefinition.h"
 #include "Weapon/OutlawAffixPoolDefinition.h"
 #include "Weapon/OutlawSkillGemDefinition.h"
 #include "Weapon/OutlawWeaponModDefinition.h"
 #include "Weapon/OutlawARPGWeaponData.h"
+#include "Weapon/OutlawShooterWeaponData.h"
+#include "Weapon/OutlawItemRandomStream.h"
+#include "AbilitySystem/OutlawWeaponAttributeSet.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogOutlawItemInstance, Log, All);
 
+namespace
+{
+	/** Magnitude an affix effect's modifier resolves to without an ASC: the rolled value for SetByCaller, else a static value. */
+	bool ResolveAffixMagnitude(const FOutlawItemAffix& Affix, const FGameplayModifierInfo& Modifier, float& OutMagnitude)
+	{
+		if (Modifier.ModifierMagnitude.GetMagnitudeCalculationType() == EGameplayEffectMagnitudeCalculation::SetByCaller)
+		{
+			const FGameplayTag& DataTag = Modifier.ModifierMagnitude.GetSetByCallerFloat().DataTag;
+			OutMagnitude = Affix.RolledValue;
+			return DataTag.IsValid() && DataTag == Affix.AffixDef->SetByCallerValueTag;
+		}
+		return Modifier.ModifierMagnitude.GetStaticMagnitudeIfPossible(1, OutMagnitude);
+	}
+
+	/**
+	 * True if the effect has a GEComponent that does more than modify attributes: granted tags or abilities, additional
+	 * effects, tag requirements, immunity, chance to apply, custom application checks, removing or blocking others.
+	 */
+	bool HasBehaviouralComponents(const UGameplayEffect& EffectCDO)
+	{
+		return EffectCDO.FindComponent<UTargetTagsGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<UAbilitiesGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<UAdditionalEffectsGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<UTargetTagRequirementsGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<UImmunityGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<UChanceToApplyGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<UCustomCanApplyGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<URemoveOtherGameplayEffectComponent>()
+			|| EffectCDO.FindComponent<UBlockAbilityTagsGameplayEffectComponent>();
+	}
+
+	/** A modifier the attribute aggregator combines by plain arithmetic: no override, no tag gating. */
+	bool IsSummableModifier(const FGameplayModifierInfo& Modifier)
+	{
+		const bool bPlainOp = Modifier.ModifierOp == EGameplayModOp::AddBase
+			|| Modifier.ModifierOp == EGameplayModOp::AddFinal
+			|| Modifier.ModifierOp == EGameplayModOp::MultiplyAdditive
+			|| Modifier.ModifierOp == EGameplayModOp::DivideAdditive
+			|| Modifier.ModifierOp == EGameplayModOp::MultiplyCompound;
+		return bPlainOp && Modifier.Attribute.IsValid() && Modifier.SourceTags.IsEmpty() && Modifier.TargetTags.IsEmpty();
+	}
+}
+
 UOutlawItemInstance::UOutlawItemInstance(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 }
 
+// ── Plain State ─────────────────────────────────────────────────
+
+void UOutlawItemInstance::InitFromWeaponState(const FOutlawItemWeaponState& State)
+{
+	CurrentAmmo = State.CurrentAmmo;
+	InstalledModTier1 = State.InstalledModTier1;
+	InstalledModTier2 = State.InstalledModTier2;
+	Quality = State.Quality;
+	Affixes = State.Affixes;
+	SocketSlots = State.SocketSlots;
+	AffixSeed = State.AffixSeed;
+	AffixItemLevel = State.AffixItemLevel;
+	MarkStatsChanged();
+}
+
+void UOutlawItemInstance::CaptureWeaponState(FOutlawItemWeaponState& OutState) const
+{
+	OutState.CurrentAmmo = CurrentAmmo;
+	OutState.InstalledModTier1 = InstalledModTier1;
+	OutState.InstalledModTier2 = InstalledModTier2;
+	OutState.Quality = Quality;
+	OutState.Affixes = Affixes;
+	OutState.SocketSlots = SocketSlots;
+	OutState.AffixSeed = AffixSeed;
+	OutState.AffixItemLevel = AffixItemLevel;
+}
+
+// ── Weapon Stats ────────────────────────────────────────────────
+
+FOutlawWeaponStatBlock UOutlawItemInstance::GetBaseWeaponStats() const
+{
+	RefreshWeaponStats();
+	return CachedBaseStats;
+}
+
+FOutlawWeaponStatBlock UOutlawItemInstance::GetWeaponStats() const
+{
+	RefreshWeaponStats();
+	return CachedFinalStats;
+}
+
+void UOutlawItemInstance::SetQuality(int32 NewQuality)
+{
+	NewQuality = FMath::Clamp(NewQuality, 0, 20);
+	if (Quality != NewQuality)
+	{
+		Quality = NewQuality;
+		MarkStatsChanged();
+	}
+}
+
+void UOutlawItemInstance::RefreshWeaponStats() const
+{
+	if (CachedStatsRevision == static_cast<int64>(StatsRevision))
+	{
+		return;
+	}
+	CachedStatsRevision = static_cast<int64>(StatsRevision);
+
+	FOutlawWeaponStatBlock Stats;
+
+	if (ItemDef && ItemDef->ShooterWeaponData)
+	{
+		const UOutlawShooterWeaponData* Data = ItemDef->ShooterWeaponData;
+		Stats.Firepower = Data->Firepower;
+		Stats.RPM = Data->RPM;
+		Stats.Accuracy = Data->Accuracy;
+		Stats.Stability = Data->Stability;
+		Stats.CritMultiplier = Data->CritMultiplier;
+		Stats.WeaponRange = Data->Range;
+	}
+
+	if (ItemDef && ItemDef->ARPGWeaponData)
+	{
+		// Quality is an ARPG weapon property, as in UOutlawARPGWeaponData::ComputeBaseDPS
+		const UOutlawARPGWeaponData* Data = ItemDef->ARPGWeaponData;
+		const float QualityMultiplier = 1.0f + FMath::Clamp(Quality, 0, 20) * 0.01f;
+		Stats.PhysicalDamageMin = Data->PhysicalDamageMin * QualityMultiplier;
+		Stats.PhysicalDamageMax = Data->PhysicalDamageMax * QualityMultiplier;
+		Stats.AttackSpeed = Data->AttackSpeed;
+		Stats.CriticalStrikeChance = Data->CriticalStrikeChance;
+	}
+
+	Stats.UpdateDPS();
+	CachedBaseStats = Stats;
+
+	// Mods and gems only grant abilities, so affixes are the one modifier layer with stats to fold in
+	struct FStatModifiers
+	{
+		float* Stat = nullptr;
+		float AddBase = 0.0f;
+		float MultiplyBias = 0.0f;
+		float DivideBias = 0.0f;
+		float MultiplyCompound = 1.0f;
+		float AddFinal = 0.0f;
+		TOptional<float> Override;
+	};
+	TArray<FStatModifiers, TInlineAllocator<10>> PerStat;
+
+	for (const FOutlawItemAffix& Affix : Affixes)
+	{
+		if (!Affix.AffixDef || !Affix.AffixDef->AffixEffect)
+		{
+			continue;
+		}
+
+		// Instant and periodic effects change base values over time rather than holding a modifier
+		const UGameplayEffect* EffectCDO = Affix.AffixDef->AffixEffect->GetDefaultObject<UGameplayEffect>();
+		if (EffectCDO->DurationPolicy == EGameplayEffectDurationType::Instant || EffectCDO->Period.GetValueAtLevel(1) > 0.0f)
+		{
+			continue;
+		}
+
+		for (const FGameplayModifierInfo& Modifier : EffectCDO->Modifiers)
+		{
+			float* Stat = UOutlawWeaponAttributeSet::FindStat(Stats, Modifier.Attribute);
+			float Magnitude = 0.0f;
+			if (!Stat || !Modifier.SourceTags.IsEmpty() || !Modifier.TargetTags.IsEmpty() || !ResolveAffixMagnitude(Affix, Modifier, Magnitude))
+			{
+				continue;
+			}
+
+			FStatModifiers* Mods = PerStat.FindByPredicate([Stat](const FStatModifiers& Entry) { return Entry.Stat == Stat; });
+			if (!Mods)
+			{
+				Mods = &PerStat.AddDefaulted_GetRef();
+				Mods->Stat = Stat;
+			}
+
+			switch (Modifier.ModifierOp)
+			{
+			case EGameplayModOp::AddBase: Mods->AddBase += Magnitude; break;
+			case EGameplayModOp::MultiplyAdditive: Mods->MultiplyBias += Magnitude - 1.0f; break;
+			case EGameplayModOp::DivideAdditive: Mods->DivideBias += Magnitude - 1.0f; break;
+			case EGameplayModOp::MultiplyCompound: Mods->MultiplyCompound *= Magnitude; break;
+			case EGameplayModOp::AddFinal: Mods->AddFinal += Magnitude; break;
+			case EGameplayModOp::Override: Mods->Override = Magnitude; break;
+			default: break;
+			}
+		}
+	}
+
+	// Same order as the attribute aggregator: ((Base + AddBase) * Multiply / Divide) * Compound + AddFinal
+	for (const FStatModifiers& Mods : PerStat)
+	{
+		if (Mods.Override.IsSet())
+		{
+			*Mods.Stat = Mods.Override.GetValue();
+			continue;
+		}
+
+		const float Divisor = 1.0f + Mods.DivideBias;
+		float Value = (*Mods.Stat + Mods.AddBase) * (1.0f + Mods.MultiplyBias);
+		Value = FMath::IsNearlyZero(Divisor) ? Value : Value / Divisor;
+		*Mods.Stat = Value * Mods.MultiplyCompound + Mods.AddFinal;
+	}
+
+	Stats.UpdateDPS();
+	CachedFinalStats = Stats;
+}
+
 // ── Shooter Mod API ─────────────────────────────────────────────
 
 void UOutlawItemInstance::InstallMod(UOutlawWeaponModDefinition* ModDef, int32 Tier, UAbilitySystemComponent* ASC)
@@ -32,6 +249,7 @@ void UOutlawItemInstance::InstallMod(UOutlawWeaponModDefinition* ModDef, int32 T
 	if (Tier == 1)
 	{
 		InstalledModTier1 = ModDef;
+		MarkStatsChanged();
 		if (ModDef->GrantedAbilitySet)
 		{
 			ModDef->GrantedAbilitySet->GiveToAbilitySystem(ASC, this, ModTier1Handles);
@@ -40,6 +258,7 @@ void UOutlawItemInstance::InstallMod(UOutlawWeaponModDefinition* ModDef, int32 T
 	else
 	{
 		InstalledModTier2 = ModDef;
+		MarkStatsChanged();
 		if (ModDef->GrantedAbilitySet)
 		{
 			ModDef->GrantedAbilitySet->GiveToAbilitySystem(ASC, this, ModTier2Handles);
@@ -60,6 +279,7 @@ void UOutlawItemInstance::RemoveMod(int32 Tier, UAbilitySystemComponent* ASC)
 		{
 			ModTier1Handles.RevokeFromASC(ASC);
 			InstalledModTier1 = nullptr;
+			MarkStatsChanged();
 		}
 	}
 	else
@@ -68,10 +288,41 @@ void UOutlawItemInstance::RemoveMod(int32 Tier, UAbilitySystemComponent* ASC)
 		{
 			ModTier2Handles.RevokeFromASC(ASC);
 			InstalledModTier2 = nullptr;
+			MarkStatsChanged();
 		}
 	}
 }
 
+void UOutlawItemInstance::GrantInstalledModAbilities(UAbilitySystemComponent* ASC)
+{
+	if (!ASC)
+	{
+		return;
+	}
+
+	RevokeInstalledModAbilities(ASC);
+
+	if (InstalledModTier1 && InstalledModTier1->GrantedAbilitySet)
+	{
+		InstalledModTier1->GrantedAbilitySet->GiveToAbilitySystem(ASC, this, ModTier1Handles);
+	}
+	if (InstalledModTier2 && InstalledModTier2->GrantedAbilitySet)
+	{
+		InstalledModTier2->GrantedAbilitySet->GiveToAbilitySystem(ASC, this, ModTier2Handles);
+	}
+}
+
+void UOutlawItemInstance::RevokeInstalledModAbilities(UAbilitySystemComponent* ASC)
+{
+	if (!ASC)
+	{
+		return;
+	}
+
+	ModTier1Handles.RevokeFromASC(ASC);
+	ModTier2Handles.RevokeFromASC(ASC);
+}
+
 // ── ARPG Gem API ────────────────────────────────────────────────
 
 bool UOutlawItemInstance::SocketGem(UOutlawSkillGemDefinition* GemDef, int32 SocketIndex)
@@ -99,6 +350,7 @@ bool UOutlawItemInstance::SocketGem(UOutlawSkillGemDefinition* GemDef, int32 Soc
 	}
 
 	Socket.SocketedGem = GemDef;
+	MarkStatsChanged();
 	return true;
 }
 
@@ -112,24 +364,37 @@ UOutlawSkillGemDefinition* UOutlawItemInstance::UnsocketGem(int32 SocketIndex)
 	FOutlawSocketSlot& Socket = SocketSlots[SocketIndex];
 	UOutlawSkillGemDefinition* RemovedGem = Socket.SocketedGem;
 	Socket.SocketedGem = nullptr;
+	if (RemovedGem)
+	{
+		MarkStatsChanged();
+	}
 	return RemovedGem;
 }
 
 // ── ARPG Affix API ──────────────────────────────────────────────
 
-void UOutlawItemInstance::RollAffixes(int32 ItemLevel)
+void UOutlawItemInstance::RollAffixes(int32 ItemLevel, int64 Seed)
 {
-	if (!ItemDef)
+	if (RollAffixesInto(ItemDef, ItemLevel, Seed, Affixes, AffixSeed))
 	{
-		return;
+		AffixItemLevel = ItemLevel;
+		MarkStatsChanged();
 	}
+}
 
-	const UOutlawARPGWeaponData* ARPGData = ItemDef->ARPGWeaponData;
+bool UOutlawItemInstance::RollAffixesInto(const UOutlawItemDefinition* InItemDef, int32 ItemLevel, int64 Seed, TArray<FOutlawItemAffix>& OutAffixes, int64& OutSeed)
+{
+	if (!InItemDef)
+	{
+		return false;
+	}
+
+	const UOutlawARPGWeaponData* ARPGData = InItemDef->ARPGWeaponData;
 	if (!ARPGData || !ARPGData->AffixPool)
 	{
 		UE_LOG(LogOutlawItemInstance, Warning, TEXT("RollAffixes: Item '%s' has no ARPG weapon data or affix pool."),
-			*ItemDef->DisplayName.ToString());
-		return;
+			*InItemDef->DisplayName.ToString());
+		return false;
 	}
 
 	// Determine number of affixes based on item level
@@ -140,7 +405,31 @@ void UOutlawItemInstance::RollAffixes(int32 ItemLevel)
 	const int32 NumPrefixes = FMath::Clamp(1 + ItemLevel / 20, 1, MaxPrefixes);
 	const int32 NumSuffixes = FMath::Clamp(1 + ItemLevel / 25, 1, MaxSuffixes);
 
-	Affixes = ARPGData->AffixPool->RollAffixes(ItemLevel, NumPrefixes, NumSuffixes);
+	// Unseeded callers still get a recorded seed, so every roll can be regenerated later
+	if (Seed == 0)
+	{
+		Seed = static_cast<int64>((static_cast<uint64>(FMath::Rand32()) << 32) | FMath::Rand32());
+	}
+
+	FOutlawItemRandomStream Stream(static_cast<uint64>(Seed));
+	OutAffixes = ARPGData->AffixPool->RollAffixes(ItemLevel, NumPrefixes, NumSuffixes, Stream);
+	OutSeed = Seed;
+	return true;
+}
+
+void UOutlawItemInstance::RegenerateAffixes()
+{
+	if (AffixSeed == 0)
+	{
+		return;
+	}
+
+	RollAffixes(AffixItemLevel, AffixSeed);
+}
+
+int64 UOutlawItemInstance::MakeAffixSeed(int64 WorldSeed, int64 DropId, int32 ItemLevel)
+{
+	return static_cast<int64>(FOutlawItemRandomStream::MakeSeed(static_cast<uint64>(WorldSeed), static_cast<uint64>(DropId), ItemLevel));
 }
 
 void UOutlawItemInstance::GrantAffixEffects(UAbilitySystemComponent* ASC)
@@ -153,15 +442,45 @@ void UOutlawItemInstance::GrantAffixEffects(UAbilitySystemComponent* ASC)
 	// Revoke any existing affix effects first
 	RevokeAffixEffects(ASC);
 
-	for (const FOutlawItemAffix& Affix : Affixes)
+	FGameplayEffectContextHandle EffectContext = ASC->MakeEffectContext();
+	EffectContext.AddSourceObject(this);
+
+	const UOutlawAffixPoolDefinition* AffixPool = ItemDef && ItemDef->ARPGWeaponData ? ItemDef->ARPGWeaponData->AffixPool.Get() : nullptr;
+	const TSubclassOf<UGameplayEffect> AggregateEffect = AffixPool ? AffixPool->AggregateAffixEffect : nullptr;
+	const bool bAggregate = AggregateEffect != nullptr;
+	if (bAggregate)
 	{
-		if (!Affix.AffixDef || !Affix.AffixDef->AffixEffect)
+		if (AggregatedAffixRevision != static_cast<int64>(StatsRevision))
 		{
-			continue;
+			BuildAggregatedAffixEffect(*AggregateEffect->GetDefaultObject<UGameplayEffect>());
 		}
 
-		FGameplayEffectContextHandle EffectContext = ASC->MakeEffectContext();
-		EffectContext.AddSourceObject(this);
+		// An asset class, so clients resolve the replicated active effect; only the summed magnitudes vary per item
+		if (!AggregatedAffixMagnitudes.IsEmpty())
+		{
+			const FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(AggregateEffect, 1, EffectContext);
+			if (SpecHandle.IsValid())
+			{
+				for (const TPair<FGameplayTag, float>& Magnitude : AggregatedAffixMagnitudes)
+				{
+					SpecHandle.Data->SetSetByCallerMagnitude(Magnitude.Key, Magnitude.Value);
+				}
+
+				const FActiveGameplayEffectHandle EffectHandle = ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+				if (EffectHandle.IsValid())
+				{
+					AffixEffectHandles.Add(EffectHandle);
+				}
+			}
+		}
+	}
+
+	auto ApplySeparately = [this, ASC, &EffectContext](const FOutlawItemAffix& Affix)
+	{
+		if (!Affix.AffixDef || !Affix.AffixDef->AffixEffect)
+		{
+			return;
+		}
 
 		FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(Affix.AffixDef->AffixEffect, 1, EffectContext);
 		if (SpecHandle.IsValid())
@@ -178,6 +497,21 @@ void UOutlawItemInstance::GrantAffixEffects(UAbilitySystemComponent* ASC)
 				AffixEffectHandles.Add(EffectHandle);
 			}
 		}
+	};
+
+	if (bAggregate)
+	{
+		for (const int32 AffixIdx : SeparateAffixIndices)
+		{
+			ApplySeparately(Affixes[AffixIdx]);
+		}
+	}
+	else
+	{
+		for (const FOutlawItemAffix& Affix : Affixes)
+		{
+			ApplySeparately(Affix);
+		}
 	}
 }
 
@@ -198,9 +532,124 @@ void UOutlawItemInstance::RevokeAffixEffects(UAbilitySystemComponent* ASC)
 	AffixEffectHandles.Reset();
 }
 
+void UOutlawItemInstance::BuildAggregatedAffixEffect(const UGameplayEffect& AggregateCDO)
+{
+	AggregatedAffixMagnitudes.Reset();
+	SeparateAffixIndices.Reset();
+	AggregatedAffixRevision = static_cast<int64>(StatsRevision);
+
+	// One SetByCaller slot per (attribute, op) on the aggregate effect, starting from the op's neutral value
+	struct FAggregateSlot
+	{
+		FGameplayAttribute Attribute;
+		EGameplayModOp::Type Op;
+		FGameplayTag DataTag;
+		float Magnitude;
+	};
+	TArray<FAggregateSlot> Slots;
+	for (const FGameplayModifierInfo& Modifier : AggregateCDO.Modifiers)
+	{
+		const FGameplayTag& DataTag = Modifier.ModifierMagnitude.GetSetByCallerFloat().DataTag;
+		if (Modifier.ModifierMagnitude.GetMagnitudeCalculationType() != EGameplayEffectMagnitudeCalculation::SetByCaller
+			|| !DataTag.IsValid() || !IsSummableModifier(Modifier))
+		{
+			continue;
+		}
+
+		const bool bAdditive = Modifier.ModifierOp == EGameplayModOp::AddBase || Modifier.ModifierOp == EGameplayModOp::AddFinal;
+		Slots.Add({ Modifier.Attribute, Modifier.ModifierOp, DataTag, bAdditive ? 0.0f : 1.0f });
+	}
+
+	// Only plain infinite stat modifiers the aggregate has a slot for can be folded together; anything with
+	// behaviour of its own (periods, executions, stacking, behavioural GEComponents, no modifiers at all,
+	// tag-gated or computed magnitudes, overrides) keeps its own effect
+	int32 AggregatedCount = 0;
+	TArray<TPair<int32, float>> Contributions;
+	for (int32 AffixIdx = 0; AffixIdx < Affixes.Num(); ++AffixIdx)
+	{
+		const FOutlawItemAffix& Affix = Affixes[AffixIdx];
+		if (!Affix.AffixDef || !Affix.AffixDef->AffixEffect)
+		{
+			continue;
+		}
+
+		const UGameplayEffect* EffectCDO = Affix.AffixDef->AffixEffect->GetDefaultObject<UGameplayEffect>();
+		bool bAggregatable = EffectCDO->DurationPolicy == EGameplayEffectDurationType::Infinite
+			&& !EffectCDO->Modifiers.IsEmpty()
+			&& EffectCDO->Period.GetValueAtLevel(1) <= 0.0f
+			&& EffectCDO->Executions.IsEmpty()
+			&& EffectCDO->GetStackingType() == EGameplayEffectStackingType::None
+			&& !HasBehaviouralComponents(*EffectCDO);
+
+		Contributions.Reset();
+		for (const FGameplayModifierInfo& Modifier : EffectCDO->Modifiers)
+		{
+			if (!bAggregatable)
+			{
+				break;
+			}
+
+			const int32 SlotIdx = Slots.IndexOfByPredicate([&Modifier](const FAggregateSlot& Slot)
+			{
+				return Slot.Attribute == Modifier.Attribute && Slot.Op == Modifier.ModifierOp;
+			});
+
+			float Magnitude = 0.0f;
+			bAggregatable = SlotIdx != INDEX_NONE && IsSummableModifier(Modifier) && ResolveAffixMagnitude(Affix, Modifier, Magnitude);
+			Contributions.Emplace(SlotIdx, Magnitude);
+		}
+
+		if (!bAggregatable)
+		{
+			SeparateAffixIndices.Add(AffixIdx);
+			continue;
+		}
+
+		// Combine exactly as the attribute aggregator would: adds sum, additive multipliers and divisors sum
+		// their bias from 1, compound multipliers multiply
+		for (const TPair<int32, float>& Contribution : Contributions)
+		{
+			FAggregateSlot& Slot = Slots[Contribution.Key];
+			if (Slot.Op == EGameplayModOp::MultiplyAdditive || Slot.Op == EGameplayModOp::DivideAdditive)
+			{
+				Slot.Magnitude += Contribution.Value - 1.0f;
+			}
+			else if (Slot.Op == EGameplayModOp::MultiplyCompound)
+			{
+				Slot.Magnitude *= Contribution.Value;
+			}
+			else
+			{
+				Slot.Magnitude += Contribution.Value;
+			}
+		}
+		++AggregatedCount;
+	}
+
+	if (AggregatedCount == 0)
+	{
+		return;
+	}
+
+	// Every slot gets a value, so untouched ones apply their neutral magnitude instead of a missing SetByCaller
+	AggregatedAffixMagnitudes.Reserve(Slots.Num());
+	for (const FAggregateSlot& Slot : Slots)
+	{
+		AggregatedAffixMagnitudes.Emplace(Slot.DataTag, Slot.Magnitude);
+	}
+
+	UE_LOG(LogOutlawItemInstance, Verbose, TEXT("Aggregated %d affixes into %d modifiers (%d applied separately)."),
+		AggregatedCount, Slots.Num(), SeparateAffixIndices.Num());
+}
+
 // ── ARPG Gem Ability API ────────────────────────────────────────
 
 void UOutlawItemInstance::GrantSocketedGemAbilities(UAbilitySystemComponent* ASC)
+{
+	GrantSocketedGemAbilitiesForWeaponSet(ASC, FGameplayTag());
+}
+
+void UOutlawItemInstance::GrantSocketedGemAbilitiesForWeaponSet(UAbilitySystemComponent* ASC, const FGameplayTag& WeaponSetTag)
 {
 	if (!ASC)
 	{
@@ -211,13 +660,14 @@ void UOutlawItemInstance::GrantSocketedGemAbilities(UAbilitySystemComponent* ASC
 	RevokeSocketedGemAbilities(ASC);
 
 	SocketedGemHandles.SetNum(SocketSlots.Num());
+	const FGameplayTagContainer SpecTags = WeaponSetTag.IsValid() ? FGameplayTagContainer(WeaponSetTag) : FGameplayTagContainer();
 
 	for (int32 i = 0; i < SocketSlots.Num(); ++i)
 	{
 		const FOutlawSocketSlot& Socket = SocketSlots[i];
 		if (Socket.SocketedGem && Socket.SocketedGem->GrantedAbilitySet)
 		{
-			Socket.SocketedGem->GrantedAbilitySet->GiveToAbilitySystem(ASC, this, SocketedGemHandles[i]);
+			Socket.SocketedGem->GrantedAbilitySet->GiveToAbilitySystem(ASC, this, SocketedGemHandles[i], SpecTags);
 		}
 	}
 }
@@ -12,6 +12,7 @@ class UOutlawItemDefinition;
 class UOutlawWeaponModDefinition;
 class UOutlawSkillGemDefinition;
 class UAbilitySystemComponent;
+class UGameplayEffect;
 
 /**
  * Per-item mutable runtime state. Weapons need this for ammo, rolled affixes, socketed gems, etc.
@@ -66,6 +67,59 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
 	TArray<FOutlawSocketSlot> SocketSlots;
 
+	/** Seed the current affixes were rolled from. 0 if they were never rolled. */
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	int64 AffixSeed = 0;
+
+	/** Item level the current affixes were rolled at. */
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	int32 AffixItemLevel = 0;
+
+	// ── Plain State ─────────────────────────────────────────────
+
+	/** Overwrite the mutable state from a struct. Does not grant anything; mods and gems are only recorded. */
+	void InitFromWeaponState(const FOutlawItemWeaponState& State);
+
+	/** Copy the mutable state out into a struct. */
+	void CaptureWeaponState(FOutlawItemWeaponState& OutState) const;
+
+	// ── Save Tracking ───────────────────────────────────────────
+
+	/** Bumped whenever saved state changes. The inventory compares it to skip re-encoding unchanged instances. */
+	uint32 GetStateRevision() const { return StateRevision; }
+
+	/** Call after writing saved state (CurrentAmmo, ...) directly; the APIs below call it themselves. */
+	UFUNCTION(BlueprintCallable, Category = "Item")
+	void MarkStateChanged() { ++StateRevision; }
+
+	// ── Weapon Stats ────────────────────────────────────────────
+
+	/**
+	 * Weapon data stats with quality applied: what the weapon manager writes to the attribute base values.
+	 * Cached; recomputed only after quality, affixes, mods or gems change.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Weapon|Stats")
+	FOutlawWeaponStatBlock GetBaseWeaponStats() const;
+
+	/**
+	 * Final stats: the base stats with the affixes' weapon attribute modifiers folded in the way the attribute
+	 * aggregator combines them. For tooltips and comparisons; needs no ASC and matches what an equipped weapon
+	 * ends up with (apart from affix effects whose magnitude is computed at runtime). Cached like GetBaseWeaponStats.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Weapon|Stats")
+	FOutlawWeaponStatBlock GetWeaponStats() const;
+
+	/** Set Quality (clamped to 0-20) and invalidate the cached stats. */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|ARPG")
+	void SetQuality(int32 NewQuality);
+
+	/** Bumped whenever something the stats depend on changes (quality, affixes, mods, gems). Implies a state change. */
+	uint32 GetStatsRevision() const { return StatsRevision; }
+
+	/** Call after writing Quality or Affixes directly. Also marks the state changed. */
+	UFUNCTION(BlueprintCallable, Category = "Item")
+	void MarkStatsChanged() { ++StatsRevision; MarkStateChanged(); }
+
 	// ── Shooter Mod API ─────────────────────────────────────────
 
 	/**
@@ -85,6 +139,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Weapon|Mods")
 	void RemoveMod(int32 Tier, UAbilitySystemComponent* ASC);
 
+	/** Grant the installed mods' ability sets, e.g. to an instance rebuilt from plain state. Replaces any held grants. */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Mods")
+	void GrantInstalledModAbilities(UAbilitySystemComponent* ASC);
+
+	/** Revoke the installed mods' ability sets but leave the mods installed, e.g. before the instance is dropped. */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Mods")
+	void RevokeInstalledModAbilities(UAbilitySystemComponent* ASC);
+
 	// ── ARPG Gem API ────────────────────────────────────────────
 
 	/**
@@ -108,14 +170,32 @@ public:
 
 	/**
 	 * Roll random affixes from the weapon's affix pool based on item level.
-	 * Replaces any existing affixes.
+	 * Replaces any existing affixes. The seed and level are stored so RegenerateAffixes can reproduce the roll.
 	 * @param ItemLevel  Determines which affixes are eligible and how many roll.
+	 * @param Seed       Generation seed, normally from MakeAffixSeed. 0 draws a fresh one from the global RNG.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Weapon|Affixes")
-	void RollAffixes(int32 ItemLevel);
+	void RollAffixes(int32 ItemLevel, int64 Seed = 0);
+
+	/** Re-roll from the stored AffixSeed and AffixItemLevel. Gives the same affixes and values as the original roll. */
+	UFUNCTION(BlueprintCallable, Category = "Weapon|Affixes")
+	void RegenerateAffixes();
+
+	/** Seed for one dropped item from the world seed, the drop's id and its item level. */
+	UFUNCTION(BlueprintPure, Category = "Weapon|Affixes")
+	static int64 MakeAffixSeed(int64 WorldSeed, int64 DropId, int32 ItemLevel);
+
+	/**
+	 * The roll behind RollAffixes, writing into plain state so inline weapon entries can be rolled without an instance.
+	 * @return False (outputs untouched) if the item has no ARPG weapon data or affix pool.
+	 */
+	static bool RollAffixesInto(const UOutlawItemDefinition* InItemDef, int32 ItemLevel, int64 Seed, TArray<FOutlawItemAffix>& OutAffixes, int64& OutSeed);
 
 	/**
 	 * Apply all affix gameplay effects to the given ASC using SetByCaller magnitude.
+	 * When the affix pool has an AggregateAffixEffect, every affix whose effect is a plain infinite stat modifier is
+	 * summed per attribute and op into that effect's SetByCaller magnitudes, so the ASC gets a single active effect
+	 * for the item. The sums are cached until the stats change, so re-equipping does no rebuild.
 	 * @param ASC  The ability system component to apply effects to.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Weapon|Affixes")
@@ -125,6 +205,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Weapon|Affixes")
 	void RevokeAffixEffects(UAbilitySystemComponent* ASC);
 
+	/** True while effects from GrantAffixEffects are applied. */
+	UFUNCTION(BlueprintPure, Category = "Weapon|Affixes")
+	bool HasAffixEffectsGranted() const { return !AffixEffectHandles.IsEmpty(); }
+
 	// ── ARPG Gem Ability API ────────────────────────────────────
 
 	/**
@@ -135,6 +219,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Weapon|Gems")
 	void GrantSocketedGemAbilities(UAbilitySystemComponent* ASC);
 
+	/**
+	 * Grant socketed gem abilities tagged with a weapon set tag (OutlawWeaponTags), so they can stay granted
+	 * while the set is inactive and only activate while the ASC carries the same tag.
+	 */
+	void GrantSocketedGemAbilitiesForWeaponSet(UAbilitySystemComponent* ASC, const FGameplayTag& WeaponSetTag);
+
 	/**
 	 * Revoke all socketed gem abilities from the ASC.
 	 * Call when this weapon becomes inactive.
@@ -153,6 +243,33 @@ private:
 	/** Handles for each socketed gem's abilities. Server-only. */
 	TArray<FOutlawAbilitySetGrantedHandles> SocketedGemHandles;
 
-	/** Handles for affix gameplay effects. Server-only. */
+	/** Handles for affix gameplay effects (the aggregated effect and any affixes applied on their own). Server-only. */
 	TArray<FActiveGameplayEffectHandle> AffixEffectHandles;
+
+	/** Rebuild AggregatedAffixMagnitudes and SeparateAffixIndices from the current affixes, against the pool's aggregate effect. */
+	void BuildAggregatedAffixEffect(const UGameplayEffect& AggregateCDO);
+
+	/** SetByCaller data tag and summed magnitude per modifier of the aggregate effect. Empty if no affix qualified. Server-only. */
+	TArray<TPair<FGameplayTag, float>> AggregatedAffixMagnitudes;
+
+	/** Affixes left out of the aggregate effect, by index. */
+	TArray<int32> SeparateAffixIndices;
+
+	/** StatsRevision the aggregate was built at; INDEX_NONE until first built. */
+	int64 AggregatedAffixRevision = INDEX_NONE;
+
+	/** Recompute CachedBaseStats and CachedFinalStats if StatsRevision moved on. */
+	void RefreshWeaponStats() const;
+
+	mutable FOutlawWeaponStatBlock CachedBaseStats;
+	mutable FOutlawWeaponStatBlock CachedFinalStats;
+
+	/** StatsRevision the cached blocks were computed at; INDEX_NONE until first computed. */
+	mutable int64 CachedStatsRevision = INDEX_NONE;
+
+	/** See GetStatsRevision. Not replicated or saved. */
+	uint32 StatsRevision = 0;
+
+	/** See GetStateRevision. Not replicated or saved. */
+	uint32 StateRevision = 0;
 };
@@ -0,0 +1,504 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OutlawStashComponent.h"
+#include "OutlawInventoryComponent.h"
+#include "OutlawItemDefinition.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogOutlawStash, Log, All);
+
+namespace OutlawStashIndex
+{
+	constexpr uint32 Magic = 0x4854534F; // "OSTH"
+	constexpr uint32 Version = 1;
+}
+
+UOutlawStashComponent::UOutlawStashComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UOutlawStashComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FlushStash();
+	Super::EndPlay(EndPlayReason);
+}
+
+// ── Store ───────────────────────────────────────────────────────
+
+bool UOutlawStashComponent::OpenStash(const FString& InStashId)
+{
+	if (InStashId.IsEmpty())
+	{
+		UE_LOG(LogOutlawStash, Warning, TEXT("OpenStash: empty stash id"));
+		return false;
+	}
+
+	FlushStash();
+	PageCache.Reset();
+
+	StashId = FPaths::MakeValidFileName(InStashId);
+	Summaries.Reset();
+	Summaries.SetNum(TabCount);
+	bIndexDirty = false;
+
+	if (!IFileManager::Get().FileExists(*GetIndexPath()))
+	{
+		return true;
+	}
+
+	if (!ReadIndex())
+	{
+		UE_LOG(LogOutlawStash, Warning, TEXT("OpenStash: could not read index of '%s'"), *StashId);
+		StashId.Reset();
+		Summaries.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void UOutlawStashComponent::FlushStash()
+{
+	if (!IsStashOpen())
+	{
+		return;
+	}
+
+	for (TPair<FIntPoint, FCachedPage>& Pair : PageCache)
+	{
+		if (Pair.Value.bDirty && WritePage(Pair.Key.X, Pair.Key.Y, Pair.Value))
+		{
+			Pair.Value.bDirty = false;
+		}
+	}
+
+	if (bIndexDirty && WriteIndex())
+	{
+		bIndexDirty = false;
+	}
+}
+
+// ── Summaries ───────────────────────────────────────────────────
+
+int32 UOutlawStashComponent::GetPageCount(int32 Tab) const
+{
+	return Summaries.IsValidIndex(Tab) ? Summaries[Tab].Num() : 0;
+}
+
+FOutlawStashPageSummary UOutlawStashComponent::GetPageSummary(int32 Tab, int32 Page) const
+{
+	return IsValidPage(Tab, Page) ? Summaries[Tab][Page] : FOutlawStashPageSummary();
+}
+
+FOutlawStashPageSummary UOutlawStashComponent::GetTabSummary(int32 Tab) const
+{
+	FOutlawStashPageSummary Total;
+	if (Summaries.IsValidIndex(Tab))
+	{
+		for (const FOutlawStashPageSummary& Summary : Summaries[Tab])
+		{
+			Total.ItemCount += Summary.ItemCount;
+			Total.StackCount += Summary.StackCount;
+			Total.Weight += Summary.Weight;
+		}
+	}
+	return Total;
+}
+
+// ── Pages ───────────────────────────────────────────────────────
+
+bool UOutlawStashComponent::GetPageItems(int32 Tab, int32 Page, TArray<FOutlawInventoryItemSaveEntry>& OutItems)
+{
+	const FCachedPage* Cached = FetchPage(Tab, Page);
+	if (!Cached)
+	{
+		return false;
+	}
+
+	OutItems = Cached->Data.Items;
+	return true;
+}
+
+// ── Transfer ────────────────────────────────────────────────────
+
+bool UOutlawStashComponent::DepositItem(UOutlawInventoryComponent* Inventory, int32 InstanceId, int32 Tab)
+{
+	if (!Inventory || !IsStashOpen() || !Summaries.IsValidIndex(Tab))
+	{
+		return false;
+	}
+
+	if (!GetOwner()->HasAuthority())
+	{
+		return false;
+	}
+
+	const FOutlawInventoryEntry* Entry = Inventory->FindEntry(InstanceId);
+	if (!Entry || !Entry->ItemDef)
+	{
+		return false;
+	}
+
+	if (Inventory->IsItemEquipped(InstanceId))
+	{
+		UE_LOG(LogOutlawStash, Warning, TEXT("DepositItem: '%s' is equipped"), *Entry->ItemDef->DisplayName.ToString());
+		return false;
+	}
+
+	FOutlawInventoryItemSaveEntry Record;
+	if (!Inventory->ExportItemRecord(InstanceId, Record))
+	{
+		return false;
+	}
+
+	// Stash placement is per page, not per grid cell; the record's InstanceId belongs to the source inventory
+	Record.InstanceId = INDEX_NONE;
+	Record.GridX = INDEX_NONE;
+	Record.GridY = INDEX_NONE;
+	Record.EquippedSlotTag = FGameplayTag();
+
+	const float Weight = Entry->ItemDef->Weight * Entry->StackCount;
+	const int32 StackCount = Entry->StackCount;
+
+	// Summaries pick the page, so a full tab is never read from disk just to find room
+	int32 Page = Summaries[Tab].IndexOfByPredicate([this](const FOutlawStashPageSummary& Summary)
+	{
+		return Summary.ItemCount < PageSize;
+	});
+
+	FCachedPage* Cached = nullptr;
+	if (Page == INDEX_NONE)
+	{
+		Page = Summaries[Tab].Num();
+		Cached = AppendPage(Tab);
+	}
+	else
+	{
+		Cached = FetchPage(Tab, Page);
+	}
+
+	if (!Cached)
+	{
+		return false;
+	}
+
+	Cached->Data.Items.Add(MoveTemp(Record));
+	Summaries[Tab][Page].Weight += Weight;
+	RefreshSummaryCounts(Tab, Page, *Cached);
+
+	// Written through before the inventory gives the item up, so the stash on disk never lags a finished deposit
+	if (!CommitPage(Tab, Page, *Cached))
+	{
+		Cached->Data.Items.Pop();
+		Summaries[Tab][Page].Weight = FMath::Max(0.0f, Summaries[Tab][Page].Weight - Weight);
+		RefreshSummaryCounts(Tab, Page, *Cached);
+		Cached->bDirty = true;
+		return false;
+	}
+
+	if (!Inventory->RemoveItem(InstanceId, StackCount))
+	{
+		// RemoveItem may have broadcast, so the page pointer is not trusted past it
+		if (FCachedPage* Reverted = FetchPage(Tab, Page))
+		{
+			Reverted->Data.Items.Pop();
+			Summaries[Tab][Page].Weight = FMath::Max(0.0f, Summaries[Tab][Page].Weight - Weight);
+			RefreshSummaryCounts(Tab, Page, *Reverted);
+			CommitPage(Tab, Page, *Reverted);
+		}
+		return false;
+	}
+
+	return true;
+}
+
+int32 UOutlawStashComponent::WithdrawItem(UOutlawInventoryComponent* Inventory, int32 Tab, int32 Page, int32 ItemIndex)
+{
+	if (!Inventory || !GetOwner()->HasAuthority())
+	{
+		return 0;
+	}
+
+	FCachedPage* Cached = FetchPage(Tab, Page);
+	if (!Cached || !Cached->Data.Items.IsValidIndex(ItemIndex))
+	{
+		return 0;
+	}
+
+	// A copy: AddItemFromRecord broadcasts synchronously, and a listener touching the stash can evict this page
+	const FOutlawInventoryItemSaveEntry Record = Cached->Data.Items[ItemIndex];
+
+	// Taken out of the stash on disk before the inventory receives it, so a crash cannot leave it in both
+	Cached->Data.Items.RemoveAt(ItemIndex);
+	RefreshSummaryCounts(Tab, Page, *Cached);
+	if (!CommitPage(Tab, Page, *Cached))
+	{
+		Cached->Data.Items.Insert(Record, ItemIndex);
+		RefreshSummaryCounts(Tab, Page, *Cached);
+		Cached->bDirty = true;
+		return 0;
+	}
+
+	const int32 Moved = Inventory->AddItemFromRecord(Record);
+
+	Cached = FetchPage(Tab, Page);
+	if (!Cached)
+	{
+		UE_LOG(LogOutlawStash, Error, TEXT("WithdrawItem: tab %d page %d of '%s' became unreadable; %d of '%s' not returned"),
+			Tab, Page, *StashId, Record.StackCount - FMath::Max(0, Moved), *Record.ItemDefPath.ToString());
+		return FMath::Max(0, Moved);
+	}
+
+	// Whatever did not fit goes back where it was
+	if (Moved < Record.StackCount)
+	{
+		FOutlawInventoryItemSaveEntry Remainder = Record;
+		Remainder.StackCount = Record.StackCount - FMath::Max(0, Moved);
+		Cached->Data.Items.Insert(MoveTemp(Remainder), FMath::Min(ItemIndex, Cached->Data.Items.Num()));
+	}
+
+	if (Moved > 0)
+	{
+		// AddItemFromRecord has loaded the definition by now
+		const UOutlawItemDefinition* ItemDef = Cast<UOutlawItemDefinition>(Record.ItemDefPath.ResolveObject());
+		FOutlawStashPageSummary& Summary = Summaries[Tab][Page];
+		Summary.Weight = FMath::Max(0.0f, Summary.Weight - (ItemDef ? ItemDef->Weight * Moved : 0.0f));
+	}
+
+	RefreshSummaryCounts(Tab, Page, *Cached);
+	CommitPage(Tab, Page, *Cached);
+	return FMath::Max(0, Moved);
+}
+
+bool UOutlawStashComponent::CommitPage(int32 Tab, int32 Page, FCachedPage& Cached)
+{
+	if (!WritePage(Tab, Page, Cached))
+	{
+		Cached.bDirty = true;
+		return false;
+	}
+	Cached.bDirty = false;
+
+	if (!WriteIndex())
+	{
+		bIndexDirty = true;
+		return false;
+	}
+	bIndexDirty = false;
+	return true;
+}
+
+// ── Page cache ──────────────────────────────────────────────────
+
+UOutlawStashComponent::FCachedPage* UOutlawStashComponent::FetchPage(int32 Tab, int32 Page)
+{
+	if (!IsStashOpen() || !IsValidPage(Tab, Page))
+	{
+		return nullptr;
+	}
+
+	const FIntPoint Key(Tab, Page);
+	if (FCachedPage* Hit = PageCache.Find(Key))
+	{
+		Hit->LastUse = ++UseClock;
+		return Hit;
+	}
+
+	FCachedPage Loaded;
+	if (Summaries[Tab][Page].ItemCount > 0)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *GetPagePath(Tab, Page)) || !Loaded.Data.LoadFromBinary(Bytes))
+		{
+			UE_LOG(LogOutlawStash, Warning, TEXT("FetchPage: could not read tab %d page %d of '%s'"), Tab, Page, *StashId);
+			return nullptr;
+		}
+	}
+
+	// Make room first so the returned pointer survives the trim
+	TrimCache();
+	FCachedPage& Added = PageCache.Add(Key, MoveTemp(Loaded));
+	Added.LastUse = ++UseClock;
+	return &Added;
+}
+
+UOutlawStashComponent::FCachedPage* UOutlawStashComponent::AppendPage(int32 Tab)
+{
+	const int32 Page = Summaries[Tab].Add(FOutlawStashPageSummary());
+	bIndexDirty = true;
+
+	TrimCache();
+	FCachedPage& Added = PageCache.Add(FIntPoint(Tab, Page));
+	Added.LastUse = ++UseClock;
+	Added.bDirty = true;
+	return &Added;
+}
+
+void UOutlawStashComponent::TrimCache()
+{
+	// Called before an insert, so leave one free place
+	while (PageCache.Num() >= FMath::Max(1, MaxCachedPages))
+	{
+		FIntPoint OldestKey;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<FIntPoint, FCachedPage>& Pair : PageCache)
+		{
+			if (Pair.Value.LastUse < OldestUse)
+			{
+				OldestKey = Pair.Key;
+				OldestUse = Pair.Value.LastUse;
+			}
+		}
+
+		const FCachedPage& Oldest = PageCache.FindChecked(OldestKey);
+		if (Oldest.bDirty && !WritePage(OldestKey.X, OldestKey.Y, Oldest))
+		{
+			// Keep unsaved records rather than losing them; the cache runs over budget until a write succeeds
+			return;
+		}
+		PageCache.Remove(OldestKey);
+	}
+}
+
+void UOutlawStashComponent::RefreshSummaryCounts(int32 Tab, int32 Page, const FCachedPage& Cached)
+{
+	FOutlawStashPageSummary& Summary = Summaries[Tab][Page];
+	Summary.ItemCount = Cached.Data.Items.Num();
+	Summary.StackCount = 0;
+	for (const FOutlawInventoryItemSaveEntry& Item : Cached.Data.Items)
+	{
+		Summary.StackCount += Item.StackCount;
+	}
+	if (Summary.ItemCount == 0)
+	{
+		Summary.Weight = 0.0f;
+	}
+	bIndexDirty = true;
+}
+
+// ── File store ──────────────────────────────────────────────────
+
+FString UOutlawStashComponent::GetStoreDir() const
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), StoreDirectory, StashId);
+}
+
+FString UOutlawStashComponent::GetPagePath(int32 Tab, int32 Page) const
+{
+	return FPaths::Combine(GetStoreDir(), FString::Printf(TEXT("Tab%d_Page%d.oinv"), Tab, Page));
+}
+
+FString UOutlawStashComponent::GetIndexPath() const
+{
+	return FPaths::Combine(GetStoreDir(), TEXT("Index.osth"));
+}
+
+bool UOutlawStashComponent::WritePage(int32 Tab, int32 Page, const FCachedPage& Cached) const
+{
+	TArray<uint8> Bytes;
+	Cached.Data.SaveToBinary(Bytes);
+	if (!FFileHelper::SaveArrayToFile(Bytes, *GetPagePath(Tab, Page)))
+	{
+		UE_LOG(LogOutlawStash, Warning, TEXT("WritePage: could not write tab %d page %d of '%s'"), Tab, Page, *StashId);
+		return false;
+	}
+	return true;
+}
+
+bool UOutlawStashComponent::ReadIndex()
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetIndexPath()))
+	{
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	Ar << Magic;
+	Ar << Version;
+	if (Ar.IsError() || Magic != OutlawStashIndex::Magic || Version == 0 || Version > OutlawStashIndex::Version)
+	{
+		return false;
+	}
+
+	uint32 StoredTabs = 0;
+	Ar.SerializeIntPacked(StoredTabs);
+	if (Ar.IsError() || StoredTabs > static_cast<uint32>(Ar.TotalSize() - Ar.Tell()))
+	{
+		return false;
+	}
+
+	// Tabs beyond TabCount (config shrank) are kept so their pages are not orphaned
+	Summaries.SetNum(FMath::Max(TabCount, static_cast<int32>(StoredTabs)));
+	for (uint32 Tab = 0; Tab < StoredTabs && !Ar.IsError(); ++Tab)
+	{
+		uint32 PageCount = 0;
+		Ar.SerializeIntPacked(PageCount);
+		if (Ar.IsError() || PageCount > static_cast<uint32>(Ar.TotalSize() - Ar.Tell()))
+		{
+			return false;
+		}
+
+		Summaries[Tab].SetNum(PageCount);
+		for (FOutlawStashPageSummary& Summary : Summaries[Tab])
+		{
+			uint32 ItemCount = 0;
+			uint32 StackCount = 0;
+			Ar.SerializeIntPacked(ItemCount);
+			Ar.SerializeIntPacked(StackCount);
+			Ar << Summary.Weight;
+			Summary.ItemCount = static_cast<int32>(ItemCount);
+			Summary.StackCount = static_cast<int32>(StackCount);
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+bool UOutlawStashComponent::WriteIndex() const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	uint32 Magic = OutlawStashIndex::Magic;
+	uint32 Version = OutlawStashIndex::Version;
+	Ar << Magic;
+	Ar << Version;
+
+	uint32 StoredTabs = Summaries.Num();
+	Ar.SerializeIntPacked(StoredTabs);
+	for (const TArray<FOutlawStashPageSummary>& Pages : Summaries)
+	{
+		uint32 PageCount = Pages.Num();
+		Ar.SerializeIntPacked(PageCount);
+		for (const FOutlawStashPageSummary& Summary : Pages)
+		{
+			uint32 ItemCount = Summary.ItemCount;
+			uint32 StackCount = Summary.StackCount;
+			float Weight = Summary.Weight;
+			Ar.SerializeIntPacked(ItemCount);
+			Ar.SerializeIntPacked(StackCount);
+			Ar << Weight;
+		}
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *GetIndexPath()))
+	{
+		UE_LOG(LogOutlawStash, Warning, TEXT("WriteIndex: could not write index of '%s'"), *StashId);
+		return false;
+	}
+	return true;
+}
+
+bool UOutlawStashComponent::IsValidPage(int32 Tab, int32 Page) const
+{
+	return Summaries.IsValidIndex(Tab) && Summaries[Tab].IsValidIndex(Page);
+}
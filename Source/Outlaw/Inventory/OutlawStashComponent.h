@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "OutlawInventoryTypes.h"
+#include "OutlawStashComponent.generated.h"
+
+class UOutlawInventoryComponent;
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawStashPageSummary — Resident totals of one stash page
+// ────────────────────────────────────────────────────────────────
+
+USTRUCT(BlueprintType)
+struct FOutlawStashPageSummary
+{
+	GENERATED_BODY()
+
+	/** Records (entries) on the page. */
+	UPROPERTY(BlueprintReadOnly, Category = "Stash")
+	int32 ItemCount = 0;
+
+	/** Sum of the records' stack counts. */
+	UPROPERTY(BlueprintReadOnly, Category = "Stash")
+	int32 StackCount = 0;
+
+	/** Total weight of the page's items. */
+	UPROPERTY(BlueprintReadOnly, Category = "Stash")
+	float Weight = 0.0f;
+};
+
+/**
+ * Account-wide stash holding items as save records in fixed-size pages, never as live inventory entries.
+ * Pages live in a local file store (one compact-binary file per page) and are read through a small LRU page cache
+ * only when a tab is opened or queried; only per-page summaries stay resident. Items move in and out through an
+ * inventory with DepositItem / WithdrawItem, so item definitions are loaded only for what is actually withdrawn.
+ * Both write the touched page and the index through before returning, rather than waiting for eviction or a flush.
+ * Server only; nothing here replicates.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class OUTLAW_API UOutlawStashComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UOutlawStashComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// ── Store ───────────────────────────────────────────────────
+
+	/**
+	 * Bind the stash to a store (e.g. the account id) and load its page summaries. Flushes a previously open store.
+	 * A store that does not exist yet opens empty.
+	 * @return False if the store's index exists but could not be read.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	bool OpenStash(const FString& InStashId);
+
+	/** Write every dirty cached page and the summary index to disk. */
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	void FlushStash();
+
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	bool IsStashOpen() const { return !StashId.IsEmpty(); }
+
+	// ── Summaries (resident, never touch disk) ──────────────────
+
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	int32 GetPageCount(int32 Tab) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	FOutlawStashPageSummary GetPageSummary(int32 Tab, int32 Page) const;
+
+	/** Page summaries of the tab added together. */
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	FOutlawStashPageSummary GetTabSummary(int32 Tab) const;
+
+	// ── Pages (loaded on demand) ────────────────────────────────
+
+	/**
+	 * Records on one page, loading it into the page cache if needed.
+	 * @return False if the tab or page does not exist or its file could not be read.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	bool GetPageItems(int32 Tab, int32 Page, TArray<FOutlawInventoryItemSaveEntry>& OutItems);
+
+	// ── Transfer ────────────────────────────────────────────────
+
+	/**
+	 * Move an inventory entry into the first page of the tab with room, appending a page if all are full.
+	 * Equipped items are refused; unequip them first.
+	 * @return True if the item was stored and removed from the inventory.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	bool DepositItem(UOutlawInventoryComponent* Inventory, int32 InstanceId, int32 Tab);
+
+	/**
+	 * Move a stored record into the inventory. If only part of a stack fits, the rest stays in the stash.
+	 * @param ItemIndex  Index of the record within the page, as returned by GetPageItems.
+	 * @return Number of items moved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Stash")
+	int32 WithdrawItem(UOutlawInventoryComponent* Inventory, int32 Tab, int32 Page, int32 ItemIndex);
+
+	// ── Configuration ───────────────────────────────────────────
+
+	/** Number of stash tabs. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stash|Config", meta = (ClampMin = "1"))
+	int32 TabCount = 4;
+
+	/** Records per page. Pages are the unit of disk I/O and caching. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stash|Config", meta = (ClampMin = "1"))
+	int32 PageSize = 64;
+
+	/** Pages kept in memory at once; the least recently used page is written back (if dirty) and dropped beyond this. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stash|Config", meta = (ClampMin = "1"))
+	int32 MaxCachedPages = 8;
+
+	/** Store root, relative to the project's Saved directory. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stash|Config")
+	FString StoreDirectory = TEXT("Stash");
+
+private:
+	struct FCachedPage
+	{
+		FOutlawInventorySaveData Data;
+		uint64 LastUse = 0;
+		bool bDirty = false;
+	};
+
+	// ── Page cache ──────────────────────────────────────────────
+
+	/** The cached page, reading it from disk (and evicting) on a miss. Null if the page does not exist or is unreadable. */
+	FCachedPage* FetchPage(int32 Tab, int32 Page);
+
+	/** Append an empty page to the tab, cached and dirty without touching disk. */
+	FCachedPage* AppendPage(int32 Tab);
+
+	/** Drop least recently used pages, writing dirty ones back, until at most MaxCachedPages remain. */
+	void TrimCache();
+
+	/** Write a page and the summary index now, as part of a transfer. False if either write failed (they stay dirty). */
+	bool CommitPage(int32 Tab, int32 Page, FCachedPage& Cached);
+
+	/** Recompute a cached page's ItemCount and StackCount from its records (weight is tracked incrementally). */
+	void RefreshSummaryCounts(int32 Tab, int32 Page, const FCachedPage& Cached);
+
+	// ── File store ──────────────────────────────────────────────
+
+	FString GetStoreDir() const;
+	FString GetPagePath(int32 Tab, int32 Page) const;
+	FString GetIndexPath() const;
+
+	bool WritePage(int32 Tab, int32 Page, const FCachedPage& Cached) const;
+	bool ReadIndex();
+	bool WriteIndex() const;
+
+	bool IsValidPage(int32 Tab, int32 Page) const;
+
+	/** Stash the store is bound to. Empty until OpenStash. */
+	FString StashId;
+
+	/** Per tab, per page. Always resident. */
+	TArray<TArray<FOutlawStashPageSummary>> Summaries;
+
+	/** Keyed by (Tab, Page). */
+	TMap<FIntPoint, FCachedPage> PageCache;
+
+	/** Monotonic clock for LRU ordering. */
+	uint64 UseClock = 0;
+
+	bool bIndexDirty = false;
+};
@@ -5,6 +5,7 @@
 #include "Inventory/OutlawInventoryComponent.h"
 #include "Inventory/OutlawItemDefinition.h"
 #include "Inventory/OutlawItemInstance.h"
+#include "Weapon/OutlawARPGWeaponData.h"
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "NiagaraComponent.h"
@@ -106,13 +107,27 @@ void AOutlawLootPickup::AttemptPickup(AActor* PickupActor)
 		return;
 	}
 
-	int32 AddedCount = InventoryComp->AddItem(const_cast<UOutlawItemDefinition*>(LootDrop.ItemDefinition.Get()), LootDrop.Quantity);
+	FOutlawItemAddRequest Request;
+	Request.ItemDef = const_cast<UOutlawItemDefinition*>(LootDrop.ItemDefinition.Get());
+	Request.Count = LootDrop.Quantity;
+
+	TArray<FOutlawItemBatchResult> Results;
+	InventoryComp->AddItems({ Request }, EOutlawInventoryBatchMode::BestEffort, Results);
+	const int32 AddedCount = Results.Num() > 0 ? Results[0].Applied : 0;
 
 	if (AddedCount > 0)
 	{
-		// TODO: Auto-roll affixes on weapon pickup
-		// Requires inventory API enhancement to return instance ID from AddItem
-		// For now, affixes can be rolled manually via Blueprint or in a future crafting system
+		// Roll affixes from the drop's seed; each weapon created from the drop gets its own sub-stream
+		const UOutlawARPGWeaponData* ARPGData = LootDrop.ItemDefinition->ARPGWeaponData;
+		if (LootDrop.AffixSeed != 0 && ARPGData && ARPGData->AffixPool)
+		{
+			const TArray<int32>& CreatedIds = Results[0].CreatedInstanceIds;
+			for (int32 i = 0; i < CreatedIds.Num(); ++i)
+			{
+				// Rolls into the item instance or, with inline weapon state, into the entry itself
+				InventoryComp->RollItemAffixes(CreatedIds[i], LootDrop.ItemLevel, UOutlawItemInstance::MakeAffixSeed(LootDrop.AffixSeed, i, LootDrop.ItemLevel));
+			}
+		}
 
 		OnLootPickedUp.Broadcast(LootDrop.ItemDefinition, AddedCount, this);
 		Destroy();
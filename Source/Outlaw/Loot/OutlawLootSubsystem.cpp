@@ -3,6 +3,7 @@
 #include "OutlawLootSubsystem.h"
 #include "OutlawLootTable.h"
 #include "OutlawLootPickup.h"
+#include "Inventory/OutlawItemInstance.h"
 #include "Engine/World.h"
 #include "Kismet/KismetMathLibrary.h"
 
@@ -12,6 +13,24 @@ UOutlawLootSubsystem::UOutlawLootSubsystem()
 {
 }
 
+void UOutlawLootSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// A fixed seed would give every session the same drop sequence; 0 is reserved for "never rolled"
+	const FGuid Entropy = FGuid::NewGuid();
+	const int64 Seed = static_cast<int64>((static_cast<uint64>(Entropy.A ^ Entropy.C) << 32) | static_cast<uint64>(Entropy.B ^ Entropy.D));
+	SetWorldSeed(Seed != 0 ? Seed : 1);
+}
+
+void UOutlawLootSubsystem::SetWorldSeed(int64 NewWorldSeed)
+{
+	WorldSeed = NewWorldSeed;
+	NextDropId = 0;
+
+	UE_LOG(LogOutlawLootSubsystem, Log, TEXT("Loot world seed for %s: %lld"), *GetNameSafe(GetWorld()), WorldSeed);
+}
+
 void UOutlawLootSubsystem::SpawnLoot(const FVector& DeathLocation, UOutlawLootTable* LootTable, int32 EnemyLevel, float RarityBonus, int32 NumDrops)
 {
 	UWorld* World = GetWorld();
@@ -31,12 +50,14 @@ void UOutlawLootSubsystem::SpawnLoot(const FVector& DeathLocation, UOutlawLootTa
 	
 	for (int32 Index = 0; Index < Drops.Num(); ++Index)
 	{
-		const FOutlawLootDrop& Drop = Drops[Index];
+		FOutlawLootDrop& Drop = Drops[Index];
 		if (!Drop.ItemDefinition)
 		{
 			continue;
 		}
 
+		Drop.AffixSeed = UOutlawItemInstance::MakeAffixSeed(WorldSeed, NextDropId++, Drop.ItemLevel);
+
 		float Angle = AngleIncrement * Index;
 		float RadialOffset = ScatterRadius * FMath::FRand();
 		FVector Offset = FVector(
@@ -18,6 +18,9 @@ class OUTLAW_API UOutlawLootSubsystem : public UWorldSubsystem
 public:
 	UOutlawLootSubsystem();
 
+	/** Draws a fresh WorldSeed for this world. */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
 	UFUNCTION(BlueprintCallable, Category = "Loot")
 	void SpawnLoot(const FVector& DeathLocation, UOutlawLootTable* LootTable, int32 EnemyLevel, float RarityBonus, int32 NumDrops = 1);
 
@@ -30,6 +33,23 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Loot|Config")
 	float DropHeight = 50.0f;
 
+	/**
+	 * Replace this world's item generation seed (e.g. to replay a reported session) and restart the drop ids.
+	 * Drops spawned afterwards roll exactly as they did in the session that logged this seed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Loot")
+	void SetWorldSeed(int64 NewWorldSeed);
+
+	/**
+	 * Seed of this world's item generation. Together with a running drop id it makes every drop's affixes reproducible.
+	 * Drawn at random (and logged) when the world starts, so each session rolls a different sequence.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Loot")
+	int64 WorldSeed = 0;
+
 private:
+	/** Running id of drops spawned in this world, mixed into each drop's affix seed. */
+	int64 NextDropId = 0;
+
 	void SpawnSinglePickup(const FOutlawLootDrop& Drop, const FVector& SpawnLocation);
 };
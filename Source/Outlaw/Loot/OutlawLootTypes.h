@@ -65,6 +65,10 @@ struct FOutlawLootDrop
 	/** The rarity tier that was rolled (may differ from ItemDefinition->Rarity if rarity is randomized). */
 	UPROPERTY(BlueprintReadOnly, Category = "Loot")
 	EOutlawItemRarity RolledRarity = EOutlawItemRarity::Common;
+
+	/** Affix generation seed for this drop (world seed, drop id, item level). 0 if not assigned. */
+	UPROPERTY(BlueprintReadOnly, Category = "Loot")
+	int64 AffixSeed = 0;
 };
 
 namespace OutlawLootTags
@@ -0,0 +1,286 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "NativeGameplayTags.h"
+#include "UObject/Package.h"
+#include "Weapon/OutlawAffixDefinition.h"
+#include "Weapon/OutlawAffixPoolDefinition.h"
+#include "Weapon/OutlawItemRandomStream.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_AffixTest_GroupA, "Affix.Group.Test.A");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_AffixTest_GroupB, "Affix.Group.Test.B");
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_AffixTest_GroupC, "Affix.Group.Test.C");
+
+namespace OutlawAffixPoolTests
+{
+	/** Ordered outcome of one roll, as indices into the pool's PossibleAffixes (base NumDefs + 1). */
+	using FOutcomeKey = int64;
+
+	FOutcomeKey AppendToKey(FOutcomeKey Key, int32 DefIndex, int32 NumDefs)
+	{
+		return Key * (NumDefs + 1) + DefIndex + 1;
+	}
+
+	/** Affixes eligible at ItemLevel for one slot, in PossibleAffixes order, as the old RollAffixes collected them. */
+	TArray<int32> EligibleIndices(const UOutlawAffixPoolDefinition& Pool, int32 ItemLevel, EOutlawAffixSlot Slot)
+	{
+		TArray<int32> Indices;
+		for (int32 i = 0; i < Pool.PossibleAffixes.Num(); ++i)
+		{
+			const UOutlawAffixDefinition* Def = Pool.PossibleAffixes[i];
+			if (Def && Def->RequiredItemLevel <= ItemLevel && Def->AffixSlot == Slot)
+			{
+				Indices.Add(i);
+			}
+		}
+		return Indices;
+	}
+
+	/**
+	 * The pre-alias-table weighted walk, kept verbatim apart from drawing from the item stream instead of FMath:
+	 * rebuild the candidate list without used groups, roll once over its total weight, walk to the pick.
+	 */
+	TArray<int32> RollWithWeightedWalk(const UOutlawAffixPoolDefinition& Pool, int32 ItemLevel, int32 NumPrefixes, int32 NumSuffixes, FOutlawItemRandomStream& Stream)
+	{
+		TArray<int32> Result;
+		TSet<FGameplayTag> UsedGroups;
+
+		auto RollFromPool = [&](const TArray<int32>& Eligible, int32 Count)
+		{
+			for (int32 i = 0; i < Count; ++i)
+			{
+				TArray<int32> Candidates;
+				int32 TotalWeight = 0;
+				for (const int32 DefIndex : Eligible)
+				{
+					const UOutlawAffixDefinition* Def = Pool.PossibleAffixes[DefIndex];
+					if (Def->AffixGroupTag.IsValid() && UsedGroups.Contains(Def->AffixGroupTag))
+					{
+						continue;
+					}
+					Candidates.Add(DefIndex);
+					TotalWeight += Def->Weight;
+				}
+
+				if (Candidates.Num() == 0 || TotalWeight <= 0)
+				{
+					break;
+				}
+
+				int64 Roll = Stream.RandRange(0, TotalWeight - 1);
+				int32 Selected = Candidates[0];
+				for (const int32 DefIndex : Candidates)
+				{
+					Roll -= Pool.PossibleAffixes[DefIndex]->Weight;
+					if (Roll < 0)
+					{
+						Selected = DefIndex;
+						break;
+					}
+				}
+
+				Result.Add(Selected);
+				if (Pool.PossibleAffixes[Selected]->AffixGroupTag.IsValid())
+				{
+					UsedGroups.Add(Pool.PossibleAffixes[Selected]->AffixGroupTag);
+				}
+			}
+		};
+
+		RollFromPool(EligibleIndices(Pool, ItemLevel, EOutlawAffixSlot::Prefix), FMath::Min(NumPrefixes, Pool.MaxPrefixes));
+		RollFromPool(EligibleIndices(Pool, ItemLevel, EOutlawAffixSlot::Suffix), FMath::Min(NumSuffixes, Pool.MaxSuffixes));
+		return Result;
+	}
+
+	/** Exact probability of every ordered outcome of the weighted walk, by enumerating each draw's candidates. */
+	void ExpectedOutcomes(const UOutlawAffixPoolDefinition& Pool, int32 ItemLevel, int32 NumPrefixes, int32 NumSuffixes, TMap<FOutcomeKey, double>& OutExpected)
+	{
+		const int32 NumDefs = Pool.PossibleAffixes.Num();
+		const TArray<int32> Prefixes = EligibleIndices(Pool, ItemLevel, EOutlawAffixSlot::Prefix);
+		const TArray<int32> Suffixes = EligibleIndices(Pool, ItemLevel, EOutlawAffixSlot::Suffix);
+		const int32 PrefixDraws = FMath::Min(NumPrefixes, Pool.MaxPrefixes);
+		const int32 SuffixDraws = FMath::Min(NumSuffixes, Pool.MaxSuffixes);
+
+		TFunction<void(int32, int32, const TSet<FGameplayTag>&, FOutcomeKey, double)> Draw;
+		Draw = [&](int32 PrefixesLeft, int32 SuffixesLeft, const TSet<FGameplayTag>& UsedGroups, FOutcomeKey Key, double Probability)
+		{
+			if (PrefixesLeft == 0 && SuffixesLeft == 0)
+			{
+				OutExpected.FindOrAdd(Key) += Probability;
+				return;
+			}
+
+			const bool bPrefix = PrefixesLeft > 0;
+			const TArray<int32>& Eligible = bPrefix ? Prefixes : Suffixes;
+
+			int64 TotalWeight = 0;
+			for (const int32 DefIndex : Eligible)
+			{
+				const UOutlawAffixDefinition* Def = Pool.PossibleAffixes[DefIndex];
+				if (!Def->AffixGroupTag.IsValid() || !UsedGroups.Contains(Def->AffixGroupTag))
+				{
+					TotalWeight += Def->Weight;
+				}
+			}
+
+			// Nothing left in this slot ends its draws, as the walk's break does
+			if (TotalWeight <= 0)
+			{
+				Draw(0, bPrefix ? SuffixesLeft : 0, UsedGroups, Key, Probability);
+				return;
+			}
+
+			for (const int32 DefIndex : Eligible)
+			{
+				const UOutlawAffixDefinition* Def = Pool.PossibleAffixes[DefIndex];
+				if (Def->Weight <= 0 || (Def->AffixGroupTag.IsValid() && UsedGroups.Contains(Def->AffixGroupTag)))
+				{
+					continue;
+				}
+
+				TSet<FGameplayTag> NextGroups = UsedGroups;
+				if (Def->AffixGroupTag.IsValid())
+				{
+					NextGroups.Add(Def->AffixGroupTag);
+				}
+				Draw(bPrefix ? PrefixesLeft - 1 : 0, bPrefix ? SuffixesLeft : SuffixesLeft - 1, NextGroups,
+					AppendToKey(Key, DefIndex, NumDefs), Probability * Def->Weight / static_cast<double>(TotalWeight));
+			}
+		};
+
+		Draw(PrefixDraws, SuffixDraws, TSet<FGameplayTag>(), 0, 1.0);
+	}
+
+	/** Upper critical value of chi-square at p = 0.001 (Wilson-Hilferty). */
+	double ChiSquareCritical(int32 DegreesOfFreedom)
+	{
+		const double K = FMath::Max(1, DegreesOfFreedom);
+		const double Z = 3.090;
+		const double Term = 1.0 - 2.0 / (9.0 * K) + Z * FMath::Sqrt(2.0 / (9.0 * K));
+		return K * Term * Term * Term;
+	}
+
+	/** Chi-square goodness of fit of Observed against Expected over Trials rolls. Fails on any impossible outcome. */
+	void CheckDistribution(FAutomationTestBase& Test, const FString& What, const TMap<FOutcomeKey, double>& Expected, const TMap<FOutcomeKey, int32>& Observed, int32 Trials)
+	{
+		for (const TPair<FOutcomeKey, int32>& Pair : Observed)
+		{
+			if (!Expected.Contains(Pair.Key))
+			{
+				Test.AddError(FString::Printf(TEXT("%s: outcome %lld can never come out of the weighted walk"), *What, Pair.Key));
+				return;
+			}
+		}
+
+		double ChiSquare = 0.0;
+		for (const TPair<FOutcomeKey, double>& Pair : Expected)
+		{
+			const double ExpectedCount = Pair.Value * Trials;
+			const double Diff = Observed.FindRef(Pair.Key) - ExpectedCount;
+			ChiSquare += Diff * Diff / ExpectedCount;
+		}
+
+		const double Critical = ChiSquareCritical(Expected.Num() - 1);
+		Test.TestTrue(FString::Printf(TEXT("%s: chi-square %.2f below %.2f (%d outcomes)"), *What, ChiSquare, Critical, Expected.Num()),
+			ChiSquare < Critical);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOutlawAffixPoolDistributionTest, "Outlaw.Weapon.AffixPool.Distribution",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOutlawAffixPoolDistributionTest::RunTest(const FString& Parameters)
+{
+	using namespace OutlawAffixPoolTests;
+
+	UOutlawAffixPoolDefinition* Pool = NewObject<UOutlawAffixPoolDefinition>(GetTransientPackage());
+	auto AddAffix = [Pool](EOutlawAffixSlot Slot, int32 Weight, int32 RequiredItemLevel, FGameplayTag Group)
+	{
+		UOutlawAffixDefinition* Def = NewObject<UOutlawAffixDefinition>(GetTransientPackage());
+		Def->AffixSlot = Slot;
+		Def->Weight = Weight;
+		Def->RequiredItemLevel = RequiredItemLevel;
+		Def->AffixGroupTag = Group;
+		Def->ValueMin = 1.0f;
+		Def->ValueMax = 2.0f;
+		Pool->PossibleAffixes.Add(Def);
+	};
+
+	// Group A holds two thirds of the level 10 prefix weight, so excluding it drops below half and takes the walk
+	// branch of PickExcluding, while excluding B (or nothing) stays on the rejection loop. Brackets start at 1, 10, 20.
+	AddAffix(EOutlawAffixSlot::Prefix, 35, 1, TAG_AffixTest_GroupA);
+	AddAffix(EOutlawAffixSlot::Prefix, 25, 10, TAG_AffixTest_GroupA);
+	AddAffix(EOutlawAffixSlot::Prefix, 20, 1, TAG_AffixTest_GroupB);
+	AddAffix(EOutlawAffixSlot::Prefix, 10, 1, FGameplayTag());
+	AddAffix(EOutlawAffixSlot::Prefix, 10, 20, TAG_AffixTest_GroupB);
+	AddAffix(EOutlawAffixSlot::Prefix, 0, 1, FGameplayTag());
+	AddAffix(EOutlawAffixSlot::Suffix, 30, 1, TAG_AffixTest_GroupA);
+	AddAffix(EOutlawAffixSlot::Suffix, 50, 1, FGameplayTag());
+	AddAffix(EOutlawAffixSlot::Suffix, 20, 10, TAG_AffixTest_GroupC);
+
+	struct FScenario
+	{
+		int32 ItemLevel;
+		int32 NumPrefixes;
+		int32 NumSuffixes;
+	};
+	const FScenario Scenarios[] = {
+		{ 0, 2, 1 },	// below the lowest bracket
+		{ 1, 1, 0 },	// single alias-table draw, lowest bracket
+		{ 9, 2, 0 },	// just below the level 10 threshold
+		{ 10, 2, 0 },	// exactly on it: walk and rejection branches
+		{ 10, 1, 1 },	// groups are exclusive across prefixes and suffixes
+		{ 19, 3, 1 },
+		{ 20, 2, 1 },	// top bracket
+		{ 99, 2, 3 },	// above every threshold; suffixes run out of groups
+	};
+
+	constexpr int32 Trials = 60000;
+	const int32 NumDefs = Pool->PossibleAffixes.Num();
+
+	for (const FScenario& Scenario : Scenarios)
+	{
+		const FString What = FString::Printf(TEXT("Level %d, %d prefixes, %d suffixes"), Scenario.ItemLevel, Scenario.NumPrefixes, Scenario.NumSuffixes);
+
+		TMap<FOutcomeKey, double> Expected;
+		ExpectedOutcomes(*Pool, Scenario.ItemLevel, Scenario.NumPrefixes, Scenario.NumSuffixes, Expected);
+
+		if (Scenario.ItemLevel < 1)
+		{
+			FOutlawItemRandomStream Stream(1);
+			TestEqual(What, Pool->RollAffixes(Scenario.ItemLevel, Scenario.NumPrefixes, Scenario.NumSuffixes, Stream).Num(), 0);
+			continue;
+		}
+
+		TMap<FOutcomeKey, int32> AliasObserved;
+		TMap<FOutcomeKey, int32> WalkObserved;
+		FOutlawItemRandomStream AliasStream(FOutlawItemRandomStream::MakeSeed(0x5EED, 1, Scenario.ItemLevel));
+		FOutlawItemRandomStream WalkStream(FOutlawItemRandomStream::MakeSeed(0x5EED, 2, Scenario.ItemLevel));
+
+		for (int32 Trial = 0; Trial < Trials; ++Trial)
+		{
+			FOutcomeKey Key = 0;
+			for (const FOutlawItemAffix& Affix : Pool->RollAffixes(Scenario.ItemLevel, Scenario.NumPrefixes, Scenario.NumSuffixes, AliasStream))
+			{
+				Key = AppendToKey(Key, Pool->PossibleAffixes.IndexOfByKey(Affix.AffixDef), NumDefs);
+			}
+			++AliasObserved.FindOrAdd(Key);
+
+			FOutcomeKey WalkKey = 0;
+			for (const int32 DefIndex : RollWithWeightedWalk(*Pool, Scenario.ItemLevel, Scenario.NumPrefixes, Scenario.NumSuffixes, WalkStream))
+			{
+				WalkKey = AppendToKey(WalkKey, DefIndex, NumDefs);
+			}
+			++WalkObserved.FindOrAdd(WalkKey);
+		}
+
+		CheckDistribution(*this, What + TEXT(" (alias tables)"), Expected, AliasObserved, Trials);
+		CheckDistribution(*this, What + TEXT(" (weighted walk)"), Expected, WalkObserved, Trials);
+	}
+
+	return true;
+}
+
+#endif
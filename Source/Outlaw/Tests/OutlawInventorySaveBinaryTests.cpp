@@ -0,0 +1,430 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "NativeGameplayTags.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Inventory/OutlawInventoryTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+UE_DEFINE_GAMEPLAY_TAG_STATIC(TAG_SaveTest_MainHand, "Equipment.Slot.Test.MainHand");
+
+namespace OutlawInventorySaveBinaryTests
+{
+	FSoftObjectPath MakePath(const TCHAR* Folder, int32 Index)
+	{
+		return FSoftObjectPath(FString::Printf(TEXT("/Game/Items/%s/DA_%s_%02d.DA_%s_%02d"), Folder, Folder, Index, Folder, Index));
+	}
+
+	FOutlawSavedAffix MakeAffix(const FSoftObjectPath& Path, float RolledValue, uint8 Slot)
+	{
+		FOutlawSavedAffix Affix;
+		Affix.AffixDefPath = Path;
+		Affix.RolledValue = RolledValue;
+		Affix.Slot = Slot;
+		return Affix;
+	}
+
+	/** One record per flag combination the encoder distinguishes. */
+	FOutlawInventorySaveData MakeCoverageData()
+	{
+		FOutlawInventorySaveData Data;
+
+		// Flat stackable: no flags at all
+		FOutlawInventoryItemSaveEntry& Flat = Data.Items.AddDefaulted_GetRef();
+		Flat.ItemDefPath = MakePath(TEXT("Ammo"), 1);
+		Flat.StackCount = 120;
+		Flat.InstanceId = 1;
+
+		// Packed grid position, both coordinates in the shared packed int
+		FOutlawInventoryItemSaveEntry& Grid = Data.Items.AddDefaulted_GetRef();
+		Grid.ItemDefPath = MakePath(TEXT("Ammo"), 1);
+		Grid.StackCount = 7;
+		Grid.InstanceId = 2;
+		Grid.GridX = 255;
+		Grid.GridY = 3;
+
+		// Wide grid: a coordinate above 255 forces the separate encoding
+		FOutlawInventoryItemSaveEntry& WideGrid = Data.Items.AddDefaulted_GetRef();
+		WideGrid.ItemDefPath = MakePath(TEXT("Junk"), 4);
+		WideGrid.StackCount = 1;
+		WideGrid.InstanceId = 300;
+		WideGrid.GridX = 2;
+		WideGrid.GridY = 256;
+
+		// Equipped weapon with every weapon field, no seed
+		FOutlawInventoryItemSaveEntry& Weapon = Data.Items.AddDefaulted_GetRef();
+		Weapon.ItemDefPath = MakePath(TEXT("Rifle"), 2);
+		Weapon.StackCount = 1;
+		Weapon.InstanceId = 4;
+		Weapon.EquippedSlotTag = TAG_SaveTest_MainHand;
+		Weapon.CurrentAmmo = 30;
+		Weapon.Quality = 12;
+		Weapon.SavedAffixes.Add(MakeAffix(MakePath(TEXT("Affix"), 1), 3.25f, 0));
+		Weapon.SavedAffixes.Add(MakeAffix(MakePath(TEXT("Affix"), 2), -0.5f, 1));
+		Weapon.SavedSocketedGems.Add(MakePath(TEXT("Gem"), 1));
+		Weapon.SavedSocketedGems.Add(FSoftObjectPath());
+		Weapon.SavedModTier1 = MakePath(TEXT("Mod"), 1);
+
+		// Seeded weapon in the grid: the version 3 seed and level ride behind their own flag
+		FOutlawInventoryItemSaveEntry& Seeded = Data.Items.AddDefaulted_GetRef();
+		Seeded.ItemDefPath = MakePath(TEXT("Sword"), 3);
+		Seeded.StackCount = 1;
+		Seeded.InstanceId = 5;
+		Seeded.GridX = 0;
+		Seeded.GridY = 0;
+		Seeded.SavedAffixes.Add(MakeAffix(MakePath(TEXT("Affix"), 1), 1.0f, 1));
+		Seeded.SavedModTier2 = MakePath(TEXT("Mod"), 2);
+		Seeded.AffixSeed = static_cast<int64>(0xD1B54A32D192ED03ull);
+		Seeded.AffixItemLevel = 42;
+
+		return Data;
+	}
+
+	/** A looted inventory: mostly stackables sharing definitions, one weapon in five with affixes and gems. */
+	FOutlawInventorySaveData MakeBulkData(int32 NumItems)
+	{
+		FRandomStream Random(0x5A7E);
+		FOutlawInventorySaveData Data;
+		for (int32 i = 0; i < NumItems; ++i)
+		{
+			FOutlawInventoryItemSaveEntry& Item = Data.Items.AddDefaulted_GetRef();
+			Item.InstanceId = i + 1;
+			Item.GridX = i % 12;
+			Item.GridY = i / 12;
+
+			if (i % 5 != 0)
+			{
+				Item.ItemDefPath = MakePath(TEXT("Material"), Random.RandHelper(40));
+				Item.StackCount = Random.RandRange(1, 99);
+				continue;
+			}
+
+			Item.ItemDefPath = MakePath(TEXT("Weapon"), Random.RandHelper(20));
+			Item.StackCount = 1;
+			Item.Quality = Random.RandRange(0, 20);
+			for (int32 Affix = Random.RandRange(1, 6); Affix > 0; --Affix)
+			{
+				Item.SavedAffixes.Add(MakeAffix(MakePath(TEXT("Affix"), Random.RandHelper(60)), Random.FRandRange(1.0f, 100.0f), static_cast<uint8>(Affix & 1)));
+			}
+			for (int32 Socket = Random.RandHelper(4); Socket > 0; --Socket)
+			{
+				Item.SavedSocketedGems.Add(MakePath(TEXT("Gem"), Random.RandHelper(15)));
+			}
+			Item.AffixSeed = (static_cast<int64>(Random.GetUnsignedInt()) << 32) | Random.GetUnsignedInt();
+			Item.AffixItemLevel = Random.RandRange(1, 80);
+		}
+		return Data;
+	}
+
+	void TestItemsEqual(FAutomationTestBase& Test, const FString& What, const FOutlawInventoryItemSaveEntry& Actual, const FOutlawInventoryItemSaveEntry& Expected)
+	{
+		Test.TestEqual(What + TEXT(" ItemDefPath"), Actual.ItemDefPath, Expected.ItemDefPath);
+		Test.TestEqual(What + TEXT(" StackCount"), Actual.StackCount, Expected.StackCount);
+		Test.TestEqual(What + TEXT(" InstanceId"), Actual.InstanceId, Expected.InstanceId);
+		Test.TestEqual(What + TEXT(" EquippedSlotTag"), Actual.EquippedSlotTag, Expected.EquippedSlotTag);
+		Test.TestEqual(What + TEXT(" GridX"), Actual.GridX, Expected.GridX);
+		Test.TestEqual(What + TEXT(" GridY"), Actual.GridY, Expected.GridY);
+		Test.TestEqual(What + TEXT(" CurrentAmmo"), Actual.CurrentAmmo, Expected.CurrentAmmo);
+		Test.TestEqual(What + TEXT(" Quality"), Actual.Quality, Expected.Quality);
+		Test.TestEqual(What + TEXT(" SavedModTier1"), Actual.SavedModTier1, Expected.SavedModTier1);
+		Test.TestEqual(What + TEXT(" SavedModTier2"), Actual.SavedModTier2, Expected.SavedModTier2);
+		Test.TestEqual(What + TEXT(" AffixSeed"), Actual.AffixSeed, Expected.AffixSeed);
+		Test.TestEqual(What + TEXT(" AffixItemLevel"), Actual.AffixItemLevel, Expected.AffixItemLevel);
+		Test.TestTrue(What + TEXT(" SavedSocketedGems"), Actual.SavedSocketedGems == Expected.SavedSocketedGems);
+
+		if (Test.TestEqual(What + TEXT(" affix count"), Actual.SavedAffixes.Num(), Expected.SavedAffixes.Num()))
+		{
+			for (int32 i = 0; i < Expected.SavedAffixes.Num(); ++i)
+			{
+				Test.TestEqual(What + TEXT(" affix path"), Actual.SavedAffixes[i].AffixDefPath, Expected.SavedAffixes[i].AffixDefPath);
+				Test.TestEqual(What + TEXT(" affix value"), Actual.SavedAffixes[i].RolledValue, Expected.SavedAffixes[i].RolledValue);
+				Test.TestEqual(What + TEXT(" affix slot"), Actual.SavedAffixes[i].Slot, Expected.SavedAffixes[i].Slot);
+			}
+		}
+	}
+
+	void TestDataEqual(FAutomationTestBase& Test, const FString& What, const FOutlawInventorySaveData& Actual, const FOutlawInventorySaveData& Expected)
+	{
+		if (Test.TestEqual(What + TEXT(" item count"), Actual.Items.Num(), Expected.Items.Num()))
+		{
+			for (int32 i = 0; i < Expected.Items.Num(); ++i)
+			{
+				TestItemsEqual(Test, FString::Printf(TEXT("%s item %d"), *What, i), Actual.Items[i], Expected.Items[i]);
+			}
+		}
+	}
+
+	/** The format binary saves replace: the struct's tagged properties, archived the way SaveGameToMemory does. */
+	void SaveTagged(FOutlawInventorySaveData& Data, TArray<uint8>& OutBytes)
+	{
+		OutBytes.Reset();
+		FMemoryWriter Writer(OutBytes, true);
+		FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+		FOutlawInventorySaveData::StaticStruct()->SerializeItem(Ar, &Data, nullptr);
+	}
+
+	void LoadTagged(const TArray<uint8>& Bytes, FOutlawInventorySaveData& OutData)
+	{
+		FMemoryReader Reader(Bytes, true);
+		FObjectAndNameAsStringProxyArchive Ar(Reader, false);
+		FOutlawInventorySaveData::StaticStruct()->SerializeItem(Ar, &OutData, nullptr);
+	}
+
+	/** Best of Iterations runs, in microseconds. */
+	template <typename FunctionType>
+	double BestMicroseconds(int32 Iterations, FunctionType Function)
+	{
+		double Best = TNumericLimits<double>::Max();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Function();
+			Best = FMath::Min(Best, FPlatformTime::Seconds() - Start);
+		}
+		return Best * 1000000.0;
+	}
+}
+
+// ── Round trip ──────────────────────────────────────────────────
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOutlawInventorySaveBinaryRoundTripTest, "Outlaw.Inventory.SaveBinary.RoundTrip",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOutlawInventorySaveBinaryRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace OutlawInventorySaveBinaryTests;
+
+	const FOutlawInventorySaveData Original = MakeCoverageData();
+
+	TArray<uint8> Bytes;
+	Original.SaveToBinary(Bytes);
+
+	FOutlawInventorySaveData Loaded;
+	if (TestTrue(TEXT("Blob decodes"), Loaded.LoadFromBinary(Bytes)))
+	{
+		TestDataEqual(*this, TEXT("Round trip"), Loaded, Original);
+	}
+
+	// Encoding is deterministic, so a decoded blob re-encodes to the same bytes
+	TArray<uint8> Reencoded;
+	Loaded.SaveToBinary(Reencoded);
+	TestTrue(TEXT("Re-encoding reproduces the blob"), Reencoded == Bytes);
+
+	FOutlawInventorySaveData Empty;
+	Empty.SaveToBinary(Bytes);
+	FOutlawInventorySaveData LoadedEmpty = MakeCoverageData();
+	TestTrue(TEXT("Empty blob decodes"), LoadedEmpty.LoadFromBinary(Bytes));
+	TestEqual(TEXT("Empty blob clears the items"), LoadedEmpty.Items.Num(), 0);
+
+	return true;
+}
+
+// ── Older versions ──────────────────────────────────────────────
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOutlawInventorySaveBinaryVersion2Test, "Outlaw.Inventory.SaveBinary.Version2",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOutlawInventorySaveBinaryVersion2Test::RunTest(const FString& Parameters)
+{
+	using namespace OutlawInventorySaveBinaryTests;
+
+	// Written field by field the way a version 2 build did: no seed flag, nothing after the weapon mods
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	auto Packed = [&Ar](uint32 Value) { Ar.SerializeIntPacked(Value); };
+	auto Utf8 = [&Ar, &Packed](const FString& String)
+	{
+		const FTCHARToUTF8 Converted(*String);
+		Packed(Converted.Length());
+		Ar.Serialize(const_cast<ANSICHAR*>(Converted.Get()), Converted.Length());
+	};
+
+	uint32 Magic = FOutlawInventorySaveData::BinaryMagic;
+	uint32 Version = 2;
+	Ar << Magic;
+	Ar << Version;
+
+	const FSoftObjectPath PotionPath = MakePath(TEXT("Potion"), 1);
+	const FSoftObjectPath PistolPath = MakePath(TEXT("Pistol"), 1);
+	const FSoftObjectPath AffixPath = MakePath(TEXT("Affix"), 9);
+	Packed(4);
+	Utf8(PotionPath.ToString());
+	Utf8(PistolPath.ToString());
+	Utf8(TAG_SaveTest_MainHand.GetTag().ToString());
+	Utf8(AffixPath.ToString());
+
+	Packed(2);
+
+	// Grid potion: flags, def, zigzag stack, zigzag id, packed (Y << 8) | X
+	uint8 Flags = 1 << 0;
+	Ar << Flags;
+	Packed(1);
+	Packed(5 << 1);
+	Packed(17 << 1);
+	Packed((4 << 8) | 6);
+
+	// Equipped pistol with one affix. The seed bit is set, as a corrupt or future writer might: version 2 must ignore it
+	Flags = (1 << 2) | (1 << 3) | (1 << 4);
+	Ar << Flags;
+	Packed(2);
+	Packed(1 << 1);
+	Packed(18 << 1);
+	Packed(3);
+	Packed(8 << 1);
+	Packed(6 << 1);
+	Packed(1);
+	Packed((4 << 1) | 1);
+	float RolledValue = 2.5f;
+	Ar << RolledValue;
+	Packed(0);
+	Packed(0);
+	Packed(0);
+
+	FOutlawInventorySaveData Loaded;
+	if (!TestTrue(TEXT("Version 2 blob decodes"), Loaded.LoadFromBinary(Bytes)) || !TestEqual(TEXT("Item count"), Loaded.Items.Num(), 2))
+	{
+		return true;
+	}
+
+	const FOutlawInventoryItemSaveEntry& Potion = Loaded.Items[0];
+	TestEqual(TEXT("Potion path"), Potion.ItemDefPath, PotionPath);
+	TestEqual(TEXT("Potion stack"), Potion.StackCount, 5);
+	TestEqual(TEXT("Potion id"), Potion.InstanceId, 17);
+	TestEqual(TEXT("Potion GridX"), Potion.GridX, 6);
+	TestEqual(TEXT("Potion GridY"), Potion.GridY, 4);
+	TestFalse(TEXT("Potion unequipped"), Potion.EquippedSlotTag.IsValid());
+
+	const FOutlawInventoryItemSaveEntry& Pistol = Loaded.Items[1];
+	TestEqual(TEXT("Pistol path"), Pistol.ItemDefPath, PistolPath);
+	TestEqual(TEXT("Pistol id"), Pistol.InstanceId, 18);
+	TestEqual(TEXT("Pistol slot"), Pistol.EquippedSlotTag, TAG_SaveTest_MainHand.GetTag());
+	TestEqual(TEXT("Pistol GridX"), Pistol.GridX, INDEX_NONE);
+	TestEqual(TEXT("Pistol ammo"), Pistol.CurrentAmmo, 8);
+	TestEqual(TEXT("Pistol quality"), Pistol.Quality, 6);
+	if (TestEqual(TEXT("Pistol affixes"), Pistol.SavedAffixes.Num(), 1))
+	{
+		TestEqual(TEXT("Affix path"), Pistol.SavedAffixes[0].AffixDefPath, AffixPath);
+		TestEqual(TEXT("Affix slot"), Pistol.SavedAffixes[0].Slot, static_cast<uint8>(1));
+		TestEqual(TEXT("Affix value"), Pistol.SavedAffixes[0].RolledValue, 2.5f);
+	}
+	TestEqual(TEXT("No seed before version 3"), Pistol.AffixSeed, static_cast<int64>(0));
+
+	// A version newer than this build is refused outright
+	Version = FOutlawInventorySaveData::BinaryVersion + 1;
+	FMemoryWriter Patch(Bytes);
+	Patch.Seek(sizeof(uint32));
+	Patch << Version;
+	TestFalse(TEXT("Future version rejected"), Loaded.LoadFromBinary(Bytes));
+	TestEqual(TEXT("Rejected load leaves the data alone"), Loaded.Items.Num(), 2);
+
+	return true;
+}
+
+// ── Malformed data ──────────────────────────────────────────────
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOutlawInventorySaveBinaryTruncatedTest, "Outlaw.Inventory.SaveBinary.Truncated",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FOutlawInventorySaveBinaryTruncatedTest::RunTest(const FString& Parameters)
+{
+	using namespace OutlawInventorySaveBinaryTests;
+
+	const FOutlawInventorySaveData Original = MakeCoverageData();
+	TArray<uint8> Bytes;
+	Original.SaveToBinary(Bytes);
+
+	// The decoder logs a warning per rejected blob; those are expected here
+	AddExpectedMessage(TEXT("LoadFromBinary"), EAutomationExpectedMessageFlags::Contains, 0);
+
+	// Every proper prefix must be refused without touching what was there
+	int32 Accepted = 0;
+	for (int32 Length = 0; Length < Bytes.Num(); ++Length)
+	{
+		FOutlawInventorySaveData Data = MakeCoverageData();
+		Data.Items.SetNum(1);
+		if (Data.LoadFromBinary(TConstArrayView<uint8>(Bytes.GetData(), Length)))
+		{
+			AddError(FString::Printf(TEXT("Blob truncated to %d of %d bytes decoded"), Length, Bytes.Num()));
+			++Accepted;
+		}
+		else if (Data.Items.Num() != 1 || Data.Items[0].InstanceId != Original.Items[0].InstanceId)
+		{
+			AddError(FString::Printf(TEXT("Blob truncated to %d bytes modified the data"), Length));
+		}
+	}
+	TestEqual(TEXT("Truncated blobs accepted"), Accepted, 0);
+
+	// A string index past the table is corruption, not an empty path
+	TArray<uint8> BadIndex;
+	{
+		FOutlawInventorySaveData OneItem;
+		OneItem.Items.Add(Original.Items[0]);
+		OneItem.SaveToBinary(BadIndex);
+	}
+	// Header (8) + table count (1) + one short string + item count (1) + flags (1): the next byte is the def index
+	const int32 DefIndexOffset = 8 + 1 + 1 + Original.Items[0].ItemDefPath.ToString().Len() + 1 + 1;
+	if (TestTrue(TEXT("Def index byte in range"), BadIndex.IsValidIndex(DefIndexOffset) && BadIndex[DefIndexOffset] == 1))
+	{
+		BadIndex[DefIndexOffset] = 2;
+		FOutlawInventorySaveData Data;
+		TestFalse(TEXT("Out of range string index rejected"), Data.LoadFromBinary(BadIndex));
+	}
+
+	TArray<uint8> BadMagic = Bytes;
+	BadMagic[0] ^= 0xFF;
+	FOutlawInventorySaveData Data;
+	TestFalse(TEXT("Wrong magic rejected"), Data.LoadFromBinary(BadMagic));
+
+	return true;
+}
+
+// ── Size and speed against tagged properties ────────────────────
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOutlawInventorySaveBinarySizeTest, "Outlaw.Inventory.SaveBinary.Size",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FOutlawInventorySaveBinarySizeTest::RunTest(const FString& Parameters)
+{
+	using namespace OutlawInventorySaveBinaryTests;
+
+	constexpr int32 NumItems = 500;
+	constexpr int32 Iterations = 50;
+
+	FOutlawInventorySaveData Data = MakeBulkData(NumItems);
+
+	TArray<uint8> TaggedBytes;
+	TArray<uint8> BinaryBytes;
+	SaveTagged(Data, TaggedBytes);
+	Data.SaveToBinary(BinaryBytes);
+
+	// Both formats must carry the same inventory before their sizes mean anything
+	FOutlawInventorySaveData FromTagged;
+	FOutlawInventorySaveData FromBinary;
+	LoadTagged(TaggedBytes, FromTagged);
+	TestTrue(TEXT("Binary decodes"), FromBinary.LoadFromBinary(BinaryBytes));
+	TestDataEqual(*this, TEXT("Tagged"), FromTagged, Data);
+	TestDataEqual(*this, TEXT("Binary"), FromBinary, Data);
+
+	TestTrue(FString::Printf(TEXT("Binary (%d bytes) smaller than tagged properties (%d bytes)"), BinaryBytes.Num(), TaggedBytes.Num()),
+		BinaryBytes.Num() < TaggedBytes.Num());
+
+	const double TaggedSave = BestMicroseconds(Iterations, [&]() { SaveTagged(Data, TaggedBytes); });
+	const double BinarySave = BestMicroseconds(Iterations, [&]() { Data.SaveToBinary(BinaryBytes); });
+	const double TaggedLoad = BestMicroseconds(Iterations, [&]() { FOutlawInventorySaveData Loaded; LoadTagged(TaggedBytes, Loaded); });
+	const double BinaryLoad = BestMicroseconds(Iterations, [&]() { FOutlawInventorySaveData Loaded; Loaded.LoadFromBinary(BinaryBytes); });
+
+	AddInfo(FString::Printf(TEXT("%d items: tagged %d bytes, binary %d bytes (%.1f%%)"),
+		NumItems, TaggedBytes.Num(), BinaryBytes.Num(), 100.0 * BinaryBytes.Num() / FMath::Max(1, TaggedBytes.Num())));
+	AddInfo(FString::Printf(TEXT("Save: tagged %.1f us, binary %.1f us. Load: tagged %.1f us, binary %.1f us (best of %d)"),
+		TaggedSave, BinarySave, TaggedLoad, BinaryLoad, Iterations));
+
+	return true;
+}
+
+#endif
@@ -1,8 +1,25 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "OutlawAffixDefinition.h"
+#include "OutlawAffixPoolDefinition.h"
+#include "UObject/UObjectIterator.h"
 
 UOutlawAffixDefinition::UOutlawAffixDefinition(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 }
+
+#if WITH_EDITOR
+void UOutlawAffixDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	for (TObjectIterator<UOutlawAffixPoolDefinition> It; It; ++It)
+	{
+		if (It->PossibleAffixes.Contains(this))
+		{
+			It->InvalidateTables();
+		}
+	}
+}
+#endif
@@ -22,6 +22,11 @@ class OUTLAW_API UOutlawAffixDefinition : public UPrimaryDataAsset
 public:
 	UOutlawAffixDefinition(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+#if WITH_EDITOR
+	/** Invalidates the compiled tables of every loaded pool listing this affix, since they bake in its weight, level, slot and group. */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	/** Display name shown in item tooltip (e.g. "of Fury", "Blazing"). */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Affix")
 	FText DisplayName;
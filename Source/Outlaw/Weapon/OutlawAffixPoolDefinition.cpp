@@ -2,6 +2,8 @@
 
 #include "OutlawAffixPoolDefinition.h"
 #include "OutlawAffixDefinition.h"
+#include "OutlawItemRandomStream.h"
+#include "Algo/BinarySearch.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogOutlawAffixPool, Log, All);
 
@@ -10,88 +12,57 @@ UOutlawAffixPoolDefinition::UOutlawAffixPoolDefinition(const FObjectInitializer&
 {
 }
 
-TArray<FOutlawItemAffix> UOutlawAffixPoolDefinition::RollAffixes(int32 ItemLevel, int32 NumPrefixes, int32 NumSuffixes) const
+void UOutlawAffixPoolDefinition::PostLoad()
 {
-	TArray<FOutlawItemAffix> Result;
+	Super::PostLoad();
+	CompileTables();
+}
 
-	// Separate eligible affixes by slot type
-	TArray<UOutlawAffixDefinition*> EligiblePrefixes;
-	TArray<UOutlawAffixDefinition*> EligibleSuffixes;
+#if WITH_EDITOR
+void UOutlawAffixPoolDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateTables();
+}
+#endif
 
-	for (const TObjectPtr<UOutlawAffixDefinition>& AffixDef : PossibleAffixes)
-	{
-		if (!AffixDef || AffixDef->RequiredItemLevel > ItemLevel)
-		{
-			continue;
-		}
+TArray<FOutlawItemAffix> UOutlawAffixPoolDefinition::RollAffixes(int32 ItemLevel, int32 NumPrefixes, int32 NumSuffixes, FOutlawItemRandomStream& Stream) const
+{
+	TArray<FOutlawItemAffix> Result;
 
-		if (AffixDef->AffixSlot == EOutlawAffixSlot::Prefix)
-		{
-			EligiblePrefixes.Add(AffixDef);
-		}
-		else
-		{
-			EligibleSuffixes.Add(AffixDef);
-		}
+	if (!bTablesCompiled)
+	{
+		CompileTables();
 	}
 
-	// Helper lambda: weighted random pick from a pool, excluding already-used group tags
-	auto RollFromPool = [&Result](TArray<UOutlawAffixDefinition*>& Pool, int32 Count, EOutlawAffixSlot Slot)
+	// Last bracket whose threshold the item level reaches; below the lowest threshold nothing is eligible
+	const int32 BracketIdx = Algo::UpperBoundBy(Brackets, ItemLevel, &FAffixLevelBracket::MinItemLevel) - 1;
+	if (!Brackets.IsValidIndex(BracketIdx))
 	{
-		TSet<FGameplayTag> UsedGroups;
+		return Result;
+	}
+	const FAffixLevelBracket& Bracket = Brackets[BracketIdx];
 
-		// Collect groups already used by previously rolled affixes
-		for (const FOutlawItemAffix& Existing : Result)
-		{
-			if (Existing.AffixDef && Existing.AffixDef->AffixGroupTag.IsValid())
-			{
-				UsedGroups.Add(Existing.AffixDef->AffixGroupTag);
-			}
-		}
+	// Groups are exclusive across prefixes and suffixes alike
+	TSet<FGameplayTag> UsedGroups;
 
+	auto RollFromTable = [&Result, &UsedGroups, &Stream](const FAffixAliasTable& Table, int32 Count, EOutlawAffixSlot Slot)
+	{
 		for (int32 i = 0; i < Count; ++i)
 		{
-			// Build weighted candidate list excluding used groups
-			TArray<UOutlawAffixDefinition*> Candidates;
-			TArray<int32> Weights;
-			int32 TotalWeight = 0;
-
-			for (UOutlawAffixDefinition* Def : Pool)
-			{
-				if (Def->AffixGroupTag.IsValid() && UsedGroups.Contains(Def->AffixGroupTag))
-				{
-					continue;
-				}
-				Candidates.Add(Def);
-				Weights.Add(Def->Weight);
-				TotalWeight += Def->Weight;
-			}
-
-			if (Candidates.Num() == 0 || TotalWeight <= 0)
+			const int32 Picked = PickExcluding(Table, UsedGroups, Stream);
+			if (Picked == INDEX_NONE)
 			{
 				break;
 			}
 
-			// Weighted random selection
-			int32 Roll = FMath::RandRange(0, TotalWeight - 1);
-			int32 SelectedIndex = 0;
-			for (int32 j = 0; j < Candidates.Num(); ++j)
-			{
-				Roll -= Weights[j];
-				if (Roll < 0)
-				{
-					SelectedIndex = j;
-					break;
-				}
-			}
-
-			UOutlawAffixDefinition* Selected = Candidates[SelectedIndex];
+			UOutlawAffixDefinition* Selected = Table.Affixes[Picked];
 
 			// Roll the value
 			FOutlawItemAffix NewAffix;
 			NewAffix.AffixDef = Selected;
 			NewAffix.Slot = Slot;
-			NewAffix.RolledValue = FMath::FRandRange(Selected->ValueMin, Selected->ValueMax);
+			NewAffix.RolledValue = Stream.FRandRange(Selected->ValueMin, Selected->ValueMax);
 			Result.Add(NewAffix);
 
 			// Mark this group as used
@@ -102,8 +73,174 @@ TArray<FOutlawItemAffix> UOutlawAffixPoolDefinition::RollAffixes(int32 ItemLevel
 		}
 	};
 
-	RollFromPool(EligiblePrefixes, FMath::Min(NumPrefixes, MaxPrefixes), EOutlawAffixSlot::Prefix);
-	RollFromPool(EligibleSuffixes, FMath::Min(NumSuffixes, MaxSuffixes), EOutlawAffixSlot::Suffix);
+	RollFromTable(Bracket.Prefixes, FMath::Min(NumPrefixes, MaxPrefixes), EOutlawAffixSlot::Prefix);
+	RollFromTable(Bracket.Suffixes, FMath::Min(NumSuffixes, MaxSuffixes), EOutlawAffixSlot::Suffix);
 
 	return Result;
 }
+
+// ── Compiled tables ─────────────────────────────────────────────
+
+void UOutlawAffixPoolDefinition::CompileTables() const
+{
+	Brackets.Reset();
+	bTablesCompiled = true;
+
+	// Zero weights could never be picked by the weighted walk either, so they are left out entirely
+	TArray<UOutlawAffixDefinition*> Usable;
+	for (const TObjectPtr<UOutlawAffixDefinition>& AffixDef : PossibleAffixes)
+	{
+		if (AffixDef && AffixDef->Weight > 0)
+		{
+			Usable.Add(AffixDef);
+		}
+	}
+
+	TArray<int32> Thresholds;
+	for (const UOutlawAffixDefinition* AffixDef : Usable)
+	{
+		Thresholds.AddUnique(AffixDef->RequiredItemLevel);
+	}
+	Thresholds.Sort();
+
+	// Each bracket is a superset of the previous one; PossibleAffixes order is kept inside every table
+	Brackets.Reserve(Thresholds.Num());
+	for (const int32 Threshold : Thresholds)
+	{
+		FAffixLevelBracket& Bracket = Brackets.AddDefaulted_GetRef();
+		Bracket.MinItemLevel = Threshold;
+
+		for (UOutlawAffixDefinition* AffixDef : Usable)
+		{
+			if (AffixDef->RequiredItemLevel > Threshold)
+			{
+				continue;
+			}
+
+			FAffixAliasTable& Table = AffixDef->AffixSlot == EOutlawAffixSlot::Prefix ? Bracket.Prefixes : Bracket.Suffixes;
+			Table.Affixes.Add(AffixDef);
+			Table.Weights.Add(AffixDef->Weight);
+		}
+
+		Bracket.Prefixes.Build();
+		Bracket.Suffixes.Build();
+	}
+
+	UE_LOG(LogOutlawAffixPool, Verbose, TEXT("%s: compiled %d affixes into %d item level brackets"), *GetName(), Usable.Num(), Brackets.Num());
+}
+
+void UOutlawAffixPoolDefinition::FAffixAliasTable::Build()
+{
+	const int32 Num = Affixes.Num();
+	TotalWeight = 0;
+	GroupWeights.Reset();
+	for (int32 i = 0; i < Num; ++i)
+	{
+		TotalWeight += Weights[i];
+		if (Affixes[i]->AffixGroupTag.IsValid())
+		{
+			GroupWeights.FindOrAdd(Affixes[i]->AffixGroupTag) += Weights[i];
+		}
+	}
+
+	Probability.SetNumUninitialized(Num);
+	Alias.SetNumUninitialized(Num);
+	if (Num == 0)
+	{
+		return;
+	}
+
+	// Vose: scale weights so the average column holds exactly 1, then pair each short column with a long one
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(Num);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	for (int32 i = 0; i < Num; ++i)
+	{
+		Scaled[i] = static_cast<double>(Weights[i]) * Num / static_cast<double>(TotalWeight);
+		(Scaled[i] < 1.0 ? Small : Large).Add(i);
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+
+		Probability[Less] = static_cast<float>(Scaled[Less]);
+		Alias[Less] = More;
+
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		(Scaled[More] < 1.0 ? Small : Large).Add(More);
+	}
+
+	// Leftovers are 1 up to rounding error
+	for (const int32 i : Large)
+	{
+		Probability[i] = 1.0f;
+		Alias[i] = i;
+	}
+	for (const int32 i : Small)
+	{
+		Probability[i] = 1.0f;
+		Alias[i] = i;
+	}
+}
+
+int32 UOutlawAffixPoolDefinition::FAffixAliasTable::Sample(FOutlawItemRandomStream& Stream) const
+{
+	const int32 Column = Stream.RandHelper(Affixes.Num());
+	return Stream.FRand() < Probability[Column] ? Column : Alias[Column];
+}
+
+int32 UOutlawAffixPoolDefinition::PickExcluding(const FAffixAliasTable& Table, const TSet<FGameplayTag>& UsedGroups, FOutlawItemRandomStream& Stream)
+{
+	if (Table.TotalWeight <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	int64 ExcludedWeight = 0;
+	for (const FGameplayTag& Group : UsedGroups)
+	{
+		ExcludedWeight += Table.GroupWeights.FindRef(Group);
+	}
+
+	const int64 RemainingWeight = Table.TotalWeight - ExcludedWeight;
+	if (RemainingWeight <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Rejecting draws from excluded groups leaves exactly the distribution over the rest. While at least half the
+	// weight is still allowed that takes under two draws on average; past that, walk the remaining candidates instead.
+	if (RemainingWeight * 2 >= Table.TotalWeight)
+	{
+		for (;;)
+		{
+			const int32 Picked = Table.Sample(Stream);
+			const FGameplayTag& Group = Table.Affixes[Picked]->AffixGroupTag;
+			if (!Group.IsValid() || !UsedGroups.Contains(Group))
+			{
+				return Picked;
+			}
+		}
+	}
+
+	int64 Roll = Stream.RandRange(0, RemainingWeight - 1);
+	for (int32 i = 0; i < Table.Affixes.Num(); ++i)
+	{
+		const FGameplayTag& Group = Table.Affixes[i]->AffixGroupTag;
+		if (Group.IsValid() && UsedGroups.Contains(Group))
+		{
+			continue;
+		}
+
+		Roll -= Table.Weights[i];
+		if (Roll < 0)
+		{
+			return i;
+		}
+	}
+
+	return INDEX_NONE;
+}
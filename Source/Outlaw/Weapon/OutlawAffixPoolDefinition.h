@@ -7,7 +7,9 @@
 #include "OutlawWeaponTypes.h"
 #include "OutlawAffixPoolDefinition.generated.h"
 
+class UGameplayEffect;
 class UOutlawAffixDefinition;
+struct FOutlawItemRandomStream;
 
 /**
  * Data asset defining a pool of possible affixes for ARPG weapons.
@@ -21,6 +23,14 @@ class OUTLAW_API UOutlawAffixPoolDefinition : public UPrimaryDataAsset
 public:
 	UOutlawAffixPoolDefinition(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	/** Recompile on the next roll; called when the pool or one of its affix definitions is edited. */
+	void InvalidateTables() const { bTablesCompiled = false; }
+#endif
+
 	/** All possible affixes that can roll from this pool. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Affix Pool")
 	TArray<TObjectPtr<UOutlawAffixDefinition>> PossibleAffixes;
@@ -33,13 +43,64 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Affix Pool", meta = (ClampMin = "0", ClampMax = "6"))
 	int32 MaxSuffixes = 3;
 
+	/**
+	 * Apply the rolled affixes of an item as one active effect instead of one per affix (see
+	 * UOutlawItemInstance::GrantAffixEffects). An Infinite effect asset with one modifier per attribute and op, each
+	 * with a SetByCaller magnitude under its own data tag; the summed affix values are passed through those tags.
+	 * Affixes that cannot be summed, or with a modifier this effect has no slot for, still apply on their own.
+	 * None applies every affix as its own effect.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Affix Pool")
+	TSubclassOf<UGameplayEffect> AggregateAffixEffect;
+
 	/**
 	 * Roll a set of affixes from this pool.
 	 * Filters by RequiredItemLevel, uses weighted random selection, and excludes duplicate AffixGroupTags.
+	 * Each pick is an O(1) alias-table draw from the item level's precompiled bracket (see CompileTables).
 	 * @param ItemLevel      The item level to filter eligible affixes.
 	 * @param NumPrefixes    Number of prefix affixes to roll.
 	 * @param NumSuffixes    Number of suffix affixes to roll.
+	 * @param Stream         Drives every pick and rolled value; the same stream state always gives the same affixes.
 	 * @return Array of rolled affixes.
 	 */
-	TArray<FOutlawItemAffix> RollAffixes(int32 ItemLevel, int32 NumPrefixes, int32 NumSuffixes) const;
+	TArray<FOutlawItemAffix> RollAffixes(int32 ItemLevel, int32 NumPrefixes, int32 NumSuffixes, FOutlawItemRandomStream& Stream) const;
+
+private:
+	/** Walker/Vose alias table over one slot's eligible affixes in one item-level bracket. */
+	struct FAffixAliasTable
+	{
+		TArray<UOutlawAffixDefinition*> Affixes;
+		TArray<int32> Weights;
+		/** Chance of keeping column i rather than taking Alias[i]. */
+		TArray<float> Probability;
+		TArray<int32> Alias;
+		/** Summed weight per AffixGroupTag, so excluding used groups needs no candidate rebuild. */
+		TMap<FGameplayTag, int64> GroupWeights;
+		int64 TotalWeight = 0;
+
+		void Build();
+		int32 Sample(FOutlawItemRandomStream& Stream) const;
+	};
+
+	/** Affixes eligible from MinItemLevel up to the next bracket's MinItemLevel. */
+	struct FAffixLevelBracket
+	{
+		int32 MinItemLevel = 0;
+		FAffixAliasTable Prefixes;
+		FAffixAliasTable Suffixes;
+	};
+
+	/**
+	 * One bracket per distinct RequiredItemLevel in PossibleAffixes, each with a prefix and a suffix alias table.
+	 * Runs on PostLoad; RollAffixes compiles on first use for pools created or edited at runtime, and after
+	 * InvalidateTables.
+	 */
+	void CompileTables() const;
+
+	/** Weighted pick from Table, skipping affixes whose group is in UsedGroups. INDEX_NONE if nothing is left. */
+	static int32 PickExcluding(const FAffixAliasTable& Table, const TSet<FGameplayTag>& UsedGroups, FOutlawItemRandomStream& Stream);
+
+	/** Sorted by MinItemLevel. */
+	mutable TArray<FAffixLevelBracket> Brackets;
+	mutable bool bTablesCompiled = false;
 };
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawItemRandomStream — Seeded RNG for item generation
+// ────────────────────────────────────────────────────────────────
+
+/**
+ * SplitMix64 stream used for everything that generates an item (affix picks, rolled values). Unlike the global
+ * FMath::Rand state it is private to one item and fully determined by its seed, so storing the seed on the item is
+ * enough to regenerate it bit-for-bit on any machine. One add, two multiplies and three xor-shifts per draw.
+ */
+struct FOutlawItemRandomStream
+{
+	explicit FOutlawItemRandomStream(uint64 InSeed)
+		: State(InSeed)
+	{
+	}
+
+	/** Combine the generation inputs into one seed. Neighbouring drop ids or levels give unrelated streams. */
+	static uint64 MakeSeed(uint64 WorldSeed, uint64 DropId, int32 ItemLevel)
+	{
+		uint64 Seed = Mix(WorldSeed);
+		Seed = Mix(Seed ^ DropId);
+		Seed = Mix(Seed ^ static_cast<uint32>(ItemLevel));
+		return Seed;
+	}
+
+	uint64 NextUInt64()
+	{
+		State += 0x9E3779B97F4A7C15ull;
+		return Mix(State);
+	}
+
+	uint32 NextUInt32()
+	{
+		return static_cast<uint32>(NextUInt64() >> 32);
+	}
+
+	/** Uniform in [0, Max). Max <= 0 returns 0. */
+	int32 RandHelper(int32 Max)
+	{
+		return Max > 0 ? static_cast<int32>((static_cast<uint64>(NextUInt32()) * static_cast<uint64>(Max)) >> 32) : 0;
+	}
+
+	/** Uniform in [Min, Max], inclusive like FMath::RandRange. */
+	int64 RandRange(int64 Min, int64 Max)
+	{
+		if (Max <= Min)
+		{
+			return Min;
+		}
+		const uint64 Span = static_cast<uint64>(Max - Min) + 1;
+		return Min + static_cast<int64>(Span ? NextUInt64() % Span : NextUInt64());
+	}
+
+	/** Uniform in [0, 1), 24 bits of precision. */
+	float FRand()
+	{
+		return static_cast<float>(NextUInt32() >> 8) * (1.0f / 16777216.0f);
+	}
+
+	/** Uniform in [Min, Max). */
+	float FRandRange(float Min, float Max)
+	{
+		return Min + (Max - Min) * FRand();
+	}
+
+private:
+	/** SplitMix64 finalizer. */
+	static uint64 Mix(uint64 Z)
+	{
+		Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+		return Z ^ (Z >> 31);
+	}
+
+	uint64 State;
+};
@@ -166,6 +166,30 @@ void UOutlawWeaponManagerComponent::SwapWeaponSet()
 		return;
 	}
 
+	// Both sets stay granted: flipping the set tag switches which abilities can activate
+	if (bKeepBothWeaponSetsGranted)
+	{
+		// The gate only stops new activations; whatever the outgoing set still has running ends here
+		CancelWeaponSetAbilities(ActiveWeaponSetIndex);
+		ActiveWeaponSetIndex = (ActiveWeaponSetIndex == 0) ? 1 : 0;
+		UpdateWeaponSetTag();
+
+		TArray<UOutlawItemInstance*> NewSetWeapons = GetWeaponsInSet(ActiveWeaponSetIndex);
+		UOutlawItemInstance* NewWeapon = NewSetWeapons.Num() > 0 ? NewSetWeapons[0] : nullptr;
+		if (NewWeapon)
+		{
+			ApplyWeaponStatsToASC(NewWeapon);
+		}
+		else
+		{
+			ClearWeaponStatsFromASC();
+		}
+
+		OnWeaponSetSwapped.Broadcast(ActiveWeaponSetIndex);
+		OnActiveWeaponChanged.Broadcast(NewWeapon);
+		return;
+	}
+
 	// Revoke abilities from current set
 	RevokeWeaponSetAbilities(ActiveWeaponSetIndex);
 
@@ -226,6 +250,18 @@ void UOutlawWeaponManagerComponent::OnWeaponEquipped(UOutlawItemInstance* Instan
 		OnActiveWeaponChanged.Broadcast(Instance);
 	}
 
+	// With both sets kept granted, re-grant the whole set so its attack abilities follow its first weapon
+	if (bKeepBothWeaponSetsGranted)
+	{
+		const int32 SetIndex = GetWeaponSetIndexForSlot(SlotTag);
+		if (SetIndex != INDEX_NONE)
+		{
+			RevokeWeaponSetAbilities(SetIndex);
+			GrantWeaponSetAbilities(SetIndex);
+		}
+		return;
+	}
+
 	// If this is in the active ARPG weapon set, grant gem abilities
 	const TArray<FGameplayTag>& ActiveSetSlots = (ActiveWeaponSetIndex == 0) ? ARPGWeaponSetI : ARPGWeaponSetII;
 	if (ActiveSetSlots.Contains(SlotTag))
@@ -252,6 +288,18 @@ void UOutlawWeaponManagerComponent::OnWeaponUnequipped(UOutlawItemInstance* Inst
 		OnActiveWeaponChanged.Broadcast(nullptr);
 	}
 
+	// The instance is still in its slot here, so leave it out when re-granting the set
+	if (bKeepBothWeaponSetsGranted)
+	{
+		const int32 SetIndex = GetWeaponSetIndexForSlot(SlotTag);
+		if (SetIndex != INDEX_NONE)
+		{
+			RevokeWeaponSetAbilities(SetIndex);
+			GrantWeaponSetAbilities(SetIndex, Instance);
+		}
+		return;
+	}
+
 	// Revoke gem abilities if in active set
 	const TArray<FGameplayTag>& ActiveSetSlots = (ActiveWeaponSetIndex == 0) ? ARPGWeaponSetI : ARPGWeaponSetII;
 	if (ActiveSetSlots.Contains(SlotTag))
@@ -279,36 +327,8 @@ void UOutlawWeaponManagerComponent::ApplyWeaponStatsToASC(UOutlawItemInstance* I
 		return;
 	}
 
-	const UOutlawWeaponAttributeSet* WeaponAttribs = ASC->GetSet<UOutlawWeaponAttributeSet>();
-	if (!WeaponAttribs)
-	{
-		return;
-	}
-
-	// Cast away const — we're the authority setting base values
-	UOutlawWeaponAttributeSet* MutableAttribs = const_cast<UOutlawWeaponAttributeSet*>(WeaponAttribs);
-
-	// Apply shooter stats
-	if (Instance->ItemDef->ShooterWeaponData)
-	{
-		const UOutlawShooterWeaponData* Data = Instance->ItemDef->ShooterWeaponData;
-		MutableAttribs->SetFirepower(Data->Firepower);
-		MutableAttribs->SetRPM(Data->RPM);
-		MutableAttribs->SetAccuracy(Data->Accuracy);
-		MutableAttribs->SetStability(Data->Stability);
-		MutableAttribs->SetCritMultiplier(Data->CritMultiplier);
-		MutableAttribs->SetWeaponRange(Data->Range);
-	}
-
-	// Apply ARPG stats
-	if (Instance->ItemDef->ARPGWeaponData)
-	{
-		const UOutlawARPGWeaponData* Data = Instance->ItemDef->ARPGWeaponData;
-		MutableAttribs->SetPhysicalDamageMin(Data->PhysicalDamageMin);
-		MutableAttribs->SetPhysicalDamageMax(Data->PhysicalDamageMax);
-		MutableAttribs->SetAttackSpeed(Data->AttackSpeed);
-		MutableAttribs->SetCriticalStrikeChance(Data->CriticalStrikeChance);
-	}
+	// One pass over the instance's cached stat block; quality is already applied, affix effects layer on top
+	UOutlawWeaponAttributeSet::ApplyStatBlock(ASC, Instance->GetBaseWeaponStats());
 }
 
 void UOutlawWeaponManagerComponent::ClearWeaponStatsFromASC()
@@ -319,23 +339,7 @@ void UOutlawWeaponManagerComponent::ClearWeaponStatsFromASC()
 		return;
 	}
 
-	const UOutlawWeaponAttributeSet* WeaponAttribs = ASC->GetSet<UOutlawWeaponAttributeSet>();
-	if (!WeaponAttribs)
-	{
-		return;
-	}
-
-	UOutlawWeaponAttributeSet* MutableAttribs = const_cast<UOutlawWeaponAttributeSet*>(WeaponAttribs);
-	MutableAttribs->SetFirepower(0.0f);
-	MutableAttribs->SetRPM(0.0f);
-	MutableAttribs->SetAccuracy(0.0f);
-	MutableAttribs->SetStability(0.0f);
-	MutableAttribs->SetCritMultiplier(0.0f);
-	MutableAttribs->SetWeaponRange(0.0f);
-	MutableAttribs->SetPhysicalDamageMin(0.0f);
-	MutableAttribs->SetPhysicalDamageMax(0.0f);
-	MutableAttribs->SetAttackSpeed(0.0f);
-	MutableAttribs->SetCriticalStrikeChance(0.0f);
+	UOutlawWeaponAttributeSet::ApplyStatBlock(ASC, FOutlawWeaponStatBlock());
 }
 
 // ── Private Helpers ─────────────────────────────────────────────
@@ -435,7 +439,7 @@ void UOutlawWeaponManagerComponent::DeactivateWeapon(UOutlawItemInstance* Instan
 	ClearWeaponStatsFromASC();
 }
 
-void UOutlawWeaponManagerComponent::GrantWeaponSetAbilities(int32 SetIndex)
+void UOutlawWeaponManagerComponent::GrantWeaponSetAbilities(int32 SetIndex, const UOutlawItemInstance* Excluding)
 {
 	UAbilitySystemComponent* ASC = GetASC();
 	if (!ASC)
@@ -443,12 +447,30 @@ void UOutlawWeaponManagerComponent::GrantWeaponSetAbilities(int32 SetIndex)
 		return;
 	}
 
+	if (bKeepBothWeaponSetsGranted)
+	{
+		UpdateWeaponSetTag();
+	}
+
+	// Untagged specs are never gated, which is what the revoke-on-swap mode relies on
+	const FGameplayTag SetTag = bKeepBothWeaponSetsGranted ? GetWeaponSetTag(SetIndex) : FGameplayTag();
+	UOutlawItemInstance* FirstWeapon = nullptr;
 	TArray<UOutlawItemInstance*> Weapons = GetWeaponsInSet(SetIndex);
 	for (UOutlawItemInstance* Weapon : Weapons)
 	{
-		if (Weapon)
+		if (Weapon && Weapon != Excluding)
+		{
+			Weapon->GrantSocketedGemAbilitiesForWeaponSet(ASC, SetTag);
+			FirstWeapon = FirstWeapon ? FirstWeapon : Weapon;
+		}
+	}
+
+	// The set's first weapon provides its attack abilities, as ActivateWeapon does on a regular swap
+	if (bKeepBothWeaponSetsGranted && FirstWeapon && FirstWeapon->ItemDef && FirstWeapon->ItemDef->ARPGWeaponData)
+	{
+		if (const UOutlawAbilitySet* AttackSet = FirstWeapon->ItemDef->ARPGWeaponData->DefaultAttackAbilitySet)
 		{
-			Weapon->GrantSocketedGemAbilities(ASC);
+			AttackSet->GiveToAbilitySystem(ASC, FirstWeapon, WeaponSetAttackHandles[SetIndex], FGameplayTagContainer(SetTag));
 		}
 	}
 }
@@ -469,4 +491,74 @@ void UOutlawWeaponManagerComponent::RevokeWeaponSetAbilities(int32 SetIndex)
 			Weapon->RevokeSocketedGemAbilities(ASC);
 		}
 	}
+
+	if (bKeepBothWeaponSetsGranted)
+	{
+		WeaponSetAttackHandles[SetIndex].RevokeFromASC(ASC);
+	}
+}
+
+int32 UOutlawWeaponManagerComponent::GetWeaponSetIndexForSlot(FGameplayTag SlotTag) const
+{
+	if (ARPGWeaponSetI.Contains(SlotTag))
+	{
+		return 0;
+	}
+	if (ARPGWeaponSetII.Contains(SlotTag))
+	{
+		return 1;
+	}
+	return INDEX_NONE;
+}
+
+FGameplayTag UOutlawWeaponManagerComponent::GetWeaponSetTag(int32 SetIndex)
+{
+	return SetIndex == 0 ? OutlawWeaponTags::WeaponSetI : OutlawWeaponTags::WeaponSetII;
+}
+
+void UOutlawWeaponManagerComponent::UpdateWeaponSetTag()
+{
+	UAbilitySystemComponent* ASC = GetASC();
+	const FGameplayTag NewTag = GetWeaponSetTag(ActiveWeaponSetIndex);
+	if (!ASC || AppliedWeaponSetTag == NewTag)
+	{
+		return;
+	}
+
+	// Replicated so owning clients can predict activation against the same set
+	if (AppliedWeaponSetTag.IsValid())
+	{
+		ASC->RemoveLooseGameplayTag(AppliedWeaponSetTag, 1, EGameplayTagReplicationState::TagOnly);
+		ASC->UnBlockAbilitiesWithTags(FGameplayTagContainer(NewTag));
+	}
+	ASC->AddLooseGameplayTag(NewTag, 1, EGameplayTagReplicationState::TagOnly);
+
+	// Abilities that carry a set tag among their own asset tags are refused by GAS itself on every activation path
+	ASC->BlockAbilitiesWithTags(FGameplayTagContainer(GetWeaponSetTag(ActiveWeaponSetIndex == 0 ? 1 : 0)));
+	AppliedWeaponSetTag = NewTag;
+}
+
+void UOutlawWeaponManagerComponent::CancelWeaponSetAbilities(int32 SetIndex)
+{
+	UAbilitySystemComponent* ASC = GetASC();
+	if (!ASC)
+	{
+		return;
+	}
+
+	// Cancelling can change the spec list, so collect first
+	const FGameplayTag SetTag = GetWeaponSetTag(SetIndex);
+	TArray<FGameplayAbilitySpecHandle, TInlineAllocator<8>> ActiveHandles;
+	for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+	{
+		if (Spec.IsActive() && Spec.GetDynamicSpecSourceTags().HasTagExact(SetTag))
+		{
+			ActiveHandles.Add(Spec.Handle);
+		}
+	}
+
+	for (const FGameplayAbilitySpecHandle& Handle : ActiveHandles)
+	{
+		ASC->CancelAbilityHandle(Handle);
+	}
 }
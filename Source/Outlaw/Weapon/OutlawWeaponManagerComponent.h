@@ -85,7 +85,7 @@ public:
 
 	/**
 	 * Toggle between weapon Set I and Set II.
-	 * Revokes old gem abilities, grants new ones.
+	 * Revokes old gem abilities, grants new ones; with bKeepBothWeaponSetsGranted only the set tag and stats change.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Weapon|ARPG")
 	void SwapWeaponSet();
@@ -140,6 +140,16 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Config|ARPG", meta = (Categories = "Equipment.Slot"))
 	TArray<FGameplayTag> ARPGWeaponSetII;
 
+	/**
+	 * Keep the gem and attack abilities of both weapon sets granted at all times instead of revoking and re-granting
+	 * them on every swap. Each set's specs carry its set tag and are refused unless the ASC has that tag (see
+	 * UOutlawAbilitySystemComponent::IsSpecInInactiveWeaponSet); abilities with a set tag among their asset tags are
+	 * also blocked through the ASC's blocked-ability tags. A swap cancels the outgoing set's running abilities, then
+	 * is one replicated tag change plus one stat block write.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Weapon|Config|ARPG")
+	bool bKeepBothWeaponSetsGranted = false;
+
 private:
 	/** Resolve the ASC from the owning actor. */
 	UAbilitySystemComponent* GetASC() const;
@@ -156,10 +166,22 @@ private:
 	/** Internal: deactivate a weapon (revoke abilities, clear stats). */
 	void DeactivateWeapon(UOutlawItemInstance* Instance);
 
-	/** Grant/revoke gem abilities for all weapons in a set. */
-	void GrantWeaponSetAbilities(int32 SetIndex);
+	/** Grant/revoke gem abilities for all weapons in a set (and, with bKeepBothWeaponSetsGranted, its attack abilities). */
+	void GrantWeaponSetAbilities(int32 SetIndex, const UOutlawItemInstance* Excluding = nullptr);
 	void RevokeWeaponSetAbilities(int32 SetIndex);
 
+	/** Set index (0 or 1) whose slots contain SlotTag, or INDEX_NONE. */
+	int32 GetWeaponSetIndexForSlot(FGameplayTag SlotTag) const;
+
+	/** Tag on the ASC while the set is active and on the specs granted for it. */
+	static FGameplayTag GetWeaponSetTag(int32 SetIndex);
+
+	/** Move the replicated set tag on the ASC to the active set, and block abilities tagged with the other set. */
+	void UpdateWeaponSetTag();
+
+	/** Cancel every running ability whose spec was granted for the set (by its set tag). */
+	void CancelWeaponSetAbilities(int32 SetIndex);
+
 	// ── Replicated State ────────────────────────────────────────
 
 	/** Currently active weapon slot tag (shooter mode). */
@@ -181,4 +203,10 @@ private:
 
 	/** Handles for ARPG weapon set gem abilities — index 0 = Set I, index 1 = Set II. */
 	TArray<FOutlawAbilitySetGrantedHandles> WeaponSetGemHandles;
+
+	/** Handles for each set's attack abilities while bKeepBothWeaponSetsGranted — index 0 = Set I, index 1 = Set II. */
+	FOutlawAbilitySetGrantedHandles WeaponSetAttackHandles[2];
+
+	/** Set tag currently on the ASC. Invalid until bKeepBothWeaponSetsGranted first applies it. */
+	FGameplayTag AppliedWeaponSetTag;
 };
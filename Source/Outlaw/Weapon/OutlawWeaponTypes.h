@@ -8,6 +8,7 @@
 
 class UOutlawAffixDefinition;
 class UOutlawSkillGemDefinition;
+class UOutlawWeaponModDefinition;
 
 // ────────────────────────────────────────────────────────────────
 // Shooter Weapon Types (Outriders-style)
@@ -43,6 +44,22 @@ enum class EOutlawARPGWeaponType : uint8
 	Spear
 };
 
+/**
+ * Namespace for Weapon Gameplay Tags.
+ * Register these tags in your project's DefaultGameplayTags.ini or via data asset.
+ */
+namespace OutlawWeaponTags
+{
+	// Weapon.Set — parent of the ARPG weapon set tags
+	inline const FGameplayTag WeaponSet = FGameplayTag::RequestGameplayTag(TEXT("Weapon.Set"));
+
+	// Weapon.Set.I — on the ASC while Set I is active; on ability specs granted for Set I
+	inline const FGameplayTag WeaponSetI = FGameplayTag::RequestGameplayTag(TEXT("Weapon.Set.I"));
+
+	// Weapon.Set.II — on the ASC while Set II is active; on ability specs granted for Set II
+	inline const FGameplayTag WeaponSetII = FGameplayTag::RequestGameplayTag(TEXT("Weapon.Set.II"));
+}
+
 // ────────────────────────────────────────────────────────────────
 // Affix Slot
 // ────────────────────────────────────────────────────────────────
@@ -110,3 +127,94 @@ struct FOutlawSocketSlot
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Socket")
 	bool bLinkedToNext;
 };
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawItemWeaponState — Mutable weapon state as a plain struct
+// ────────────────────────────────────────────────────────────────
+
+/**
+ * The saved/replicated part of UOutlawItemInstance, without the ability handles.
+ * Lets an inventory keep unequipped weapons inline in its entries instead of as one UObject each.
+ */
+USTRUCT(BlueprintType)
+struct FOutlawItemWeaponState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	int32 CurrentAmmo = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	TObjectPtr<UOutlawWeaponModDefinition> InstalledModTier1;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	TObjectPtr<UOutlawWeaponModDefinition> InstalledModTier2;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	int32 Quality = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	TArray<FOutlawItemAffix> Affixes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	TArray<FOutlawSocketSlot> SocketSlots;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	int64 AffixSeed = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	int32 AffixItemLevel = 0;
+};
+
+// ────────────────────────────────────────────────────────────────
+// FOutlawWeaponStatBlock — One weapon's stats in one place
+// ────────────────────────────────────────────────────────────────
+
+/**
+ * The ten UOutlawWeaponAttributeSet stats of one weapon, plus the DPS they add up to.
+ * Computed and cached by UOutlawItemInstance (GetBaseWeaponStats / GetWeaponStats).
+ */
+USTRUCT(BlueprintType)
+struct FOutlawWeaponStatBlock
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	float Firepower = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	float RPM = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	float Accuracy = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	float Stability = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	float CritMultiplier = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|Shooter")
+	float WeaponRange = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	float PhysicalDamageMin = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	float PhysicalDamageMax = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	float AttackSpeed = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon|ARPG")
+	float CriticalStrikeChance = 0.0f;
+
+	/** Damage per second before crits: Firepower * RPM / 60 for shooter weapons, average hit * AttackSpeed for ARPG ones. */
+	UPROPERTY(BlueprintReadOnly, Category = "Weapon")
+	float DPS = 0.0f;
+
+	void UpdateDPS()
+	{
+		DPS = Firepower * RPM / 60.0f + (PhysicalDamageMin + PhysicalDamageMax) * 0.5f * AttackSpeed;
+	}
+};